@@ -0,0 +1,265 @@
+#ifndef stemr_dual_h
+#define stemr_dual_h
+
+#include <array>
+#include <cmath>
+
+// forward mode automatic differentiation. a dual number carries a value and its gradient with
+// respect to N independent variables, so that evaluating a function templated on the number type
+// with dual arguments yields the function values together with the Jacobian in a single pass.
+// this header is pasted into the generated LNA code, where the rates are evaluated with duals
+// over the log counting processes.
+namespace stemr_ad {
+
+template <int N>
+struct dual {
+
+      double val;
+      std::array<double, N> grad;
+
+      dual() : val(0.0) { grad.fill(0.0); }
+
+      // constants have zero gradient
+      dual(double v) : val(v) { grad.fill(0.0); }
+
+      // the i-th independent variable
+      dual(double v, int i) : val(v) { grad.fill(0.0); grad[i] = 1.0; }
+
+      dual& operator+=(const dual& y) {
+            val += y.val;
+            for(int i = 0; i < N; ++i) grad[i] += y.grad[i];
+            return *this;
+      }
+
+      dual& operator-=(const dual& y) {
+            val -= y.val;
+            for(int i = 0; i < N; ++i) grad[i] -= y.grad[i];
+            return *this;
+      }
+
+      dual& operator*=(const dual& y) {
+            for(int i = 0; i < N; ++i) grad[i] = grad[i] * y.val + val * y.grad[i];
+            val *= y.val;
+            return *this;
+      }
+
+      dual& operator/=(const dual& y) {
+            double inv = 1.0 / y.val;
+            val *= inv;
+            for(int i = 0; i < N; ++i) grad[i] = (grad[i] - val * y.grad[i]) * inv;
+            return *this;
+      }
+
+      dual& operator+=(double y) { val += y; return *this; }
+      dual& operator-=(double y) { val -= y; return *this; }
+
+      dual& operator*=(double y) {
+            val *= y;
+            for(int i = 0; i < N; ++i) grad[i] *= y;
+            return *this;
+      }
+
+      dual& operator/=(double y) { return *this *= 1.0 / y; }
+};
+
+// function with value f and derivative df at x.val, applied to x by the chain rule
+template <int N>
+inline dual<N> chain(const dual<N>& x, double f, double df) {
+      dual<N> y(f);
+      for(int i = 0; i < N; ++i) y.grad[i] = df * x.grad[i];
+      return y;
+}
+
+template <int N> inline dual<N> operator+(const dual<N>& x) { return x; }
+template <int N> inline dual<N> operator-(const dual<N>& x) { return chain(x, -x.val, -1.0); }
+
+template <int N> inline dual<N> operator+(dual<N> x, const dual<N>& y) { return x += y; }
+template <int N> inline dual<N> operator-(dual<N> x, const dual<N>& y) { return x -= y; }
+template <int N> inline dual<N> operator*(dual<N> x, const dual<N>& y) { return x *= y; }
+template <int N> inline dual<N> operator/(dual<N> x, const dual<N>& y) { return x /= y; }
+
+template <int N> inline dual<N> operator+(dual<N> x, double y) { return x += y; }
+template <int N> inline dual<N> operator-(dual<N> x, double y) { return x -= y; }
+template <int N> inline dual<N> operator*(dual<N> x, double y) { return x *= y; }
+template <int N> inline dual<N> operator/(dual<N> x, double y) { return x /= y; }
+
+template <int N> inline dual<N> operator+(double x, dual<N> y) { return y += x; }
+template <int N> inline dual<N> operator-(double x, const dual<N>& y) { return chain(y, x - y.val, -1.0); }
+template <int N> inline dual<N> operator*(double x, dual<N> y) { return y *= x; }
+template <int N> inline dual<N> operator/(double x, const dual<N>& y) {
+      double f = x / y.val;
+      return chain(y, f, -f / y.val);
+}
+
+template <int N> inline dual<N> exp(const dual<N>& x) {
+      double f = std::exp(x.val);
+      return chain(x, f, f);
+}
+
+template <int N> inline dual<N> expm1(const dual<N>& x) {
+      return chain(x, std::expm1(x.val), std::exp(x.val));
+}
+
+template <int N> inline dual<N> log(const dual<N>& x) {
+      return chain(x, std::log(x.val), 1.0 / x.val);
+}
+
+template <int N> inline dual<N> log1p(const dual<N>& x) {
+      return chain(x, std::log1p(x.val), 1.0 / (1.0 + x.val));
+}
+
+template <int N> inline dual<N> sqrt(const dual<N>& x) {
+      double f = std::sqrt(x.val);
+      return chain(x, f, 0.5 / f);
+}
+
+template <int N> inline dual<N> fabs(const dual<N>& x) {
+      return chain(x, std::fabs(x.val), x.val < 0 ? -1.0 : 1.0);
+}
+
+template <int N> inline dual<N> pow(const dual<N>& x, double p) {
+      return chain(x, std::pow(x.val, p), p * std::pow(x.val, p - 1.0));
+}
+
+template <int N> inline dual<N> pow(double x, const dual<N>& p) {
+      double f = std::pow(x, p.val);
+      return chain(p, f, f * std::log(x));
+}
+
+template <int N> inline dual<N> pow(const dual<N>& x, const dual<N>& p) {
+      return exp(p * log(x));
+}
+
+template <int N> inline dual<N> abs(const dual<N>& x) { return fabs(x); }
+
+template <int N> inline dual<N> cbrt(const dual<N>& x) {
+      double f = std::cbrt(x.val);
+      return chain(x, f, 1.0 / (3.0 * f * f));
+}
+
+template <int N> inline dual<N> log2(const dual<N>& x) {
+      return chain(x, std::log2(x.val), 1.0 / (x.val * std::log(2.0)));
+}
+
+template <int N> inline dual<N> log10(const dual<N>& x) {
+      return chain(x, std::log10(x.val), 1.0 / (x.val * std::log(10.0)));
+}
+
+template <int N> inline dual<N> sin(const dual<N>& x) {
+      return chain(x, std::sin(x.val), std::cos(x.val));
+}
+
+template <int N> inline dual<N> cos(const dual<N>& x) {
+      return chain(x, std::cos(x.val), -std::sin(x.val));
+}
+
+template <int N> inline dual<N> tan(const dual<N>& x) {
+      double f = std::tan(x.val);
+      return chain(x, f, 1.0 + f * f);
+}
+
+template <int N> inline dual<N> asin(const dual<N>& x) {
+      return chain(x, std::asin(x.val), 1.0 / std::sqrt(1.0 - x.val * x.val));
+}
+
+template <int N> inline dual<N> acos(const dual<N>& x) {
+      return chain(x, std::acos(x.val), -1.0 / std::sqrt(1.0 - x.val * x.val));
+}
+
+template <int N> inline dual<N> atan(const dual<N>& x) {
+      return chain(x, std::atan(x.val), 1.0 / (1.0 + x.val * x.val));
+}
+
+template <int N> inline dual<N> sinh(const dual<N>& x) {
+      return chain(x, std::sinh(x.val), std::cosh(x.val));
+}
+
+template <int N> inline dual<N> cosh(const dual<N>& x) {
+      return chain(x, std::cosh(x.val), std::sinh(x.val));
+}
+
+template <int N> inline dual<N> tanh(const dual<N>& x) {
+      double f = std::tanh(x.val);
+      return chain(x, f, 1.0 - f * f);
+}
+
+// comparisons are made on the values, the minimum and maximum take the gradient of the selected
+// argument, that of the first on ties
+template <int N> inline bool operator==(const dual<N>& x, const dual<N>& y) { return x.val == y.val; }
+template <int N> inline bool operator!=(const dual<N>& x, const dual<N>& y) { return x.val != y.val; }
+template <int N> inline bool operator< (const dual<N>& x, const dual<N>& y) { return x.val <  y.val; }
+template <int N> inline bool operator> (const dual<N>& x, const dual<N>& y) { return x.val >  y.val; }
+template <int N> inline bool operator<=(const dual<N>& x, const dual<N>& y) { return x.val <= y.val; }
+template <int N> inline bool operator>=(const dual<N>& x, const dual<N>& y) { return x.val >= y.val; }
+
+template <int N> inline bool operator==(const dual<N>& x, double y) { return x.val == y; }
+template <int N> inline bool operator!=(const dual<N>& x, double y) { return x.val != y; }
+template <int N> inline bool operator< (const dual<N>& x, double y) { return x.val <  y; }
+template <int N> inline bool operator> (const dual<N>& x, double y) { return x.val >  y; }
+template <int N> inline bool operator<=(const dual<N>& x, double y) { return x.val <= y; }
+template <int N> inline bool operator>=(const dual<N>& x, double y) { return x.val >= y; }
+
+template <int N> inline bool operator==(double x, const dual<N>& y) { return x == y.val; }
+template <int N> inline bool operator!=(double x, const dual<N>& y) { return x != y.val; }
+template <int N> inline bool operator< (double x, const dual<N>& y) { return x <  y.val; }
+template <int N> inline bool operator> (double x, const dual<N>& y) { return x >  y.val; }
+template <int N> inline bool operator<=(double x, const dual<N>& y) { return x <= y.val; }
+template <int N> inline bool operator>=(double x, const dual<N>& y) { return x >= y.val; }
+
+template <int N> inline dual<N> fmin(const dual<N>& x, const dual<N>& y) { return y.val < x.val ? y : x; }
+template <int N> inline dual<N> fmax(const dual<N>& x, const dual<N>& y) { return y.val > x.val ? y : x; }
+template <int N> inline dual<N> fmin(const dual<N>& x, double y) { return y < x.val ? dual<N>(y) : x; }
+template <int N> inline dual<N> fmax(const dual<N>& x, double y) { return y > x.val ? dual<N>(y) : x; }
+template <int N> inline dual<N> fmin(double x, const dual<N>& y) { return y.val < x ? y : dual<N>(x); }
+template <int N> inline dual<N> fmax(double x, const dual<N>& y) { return y.val > x ? y : dual<N>(x); }
+
+template <int N> inline dual<N> min(const dual<N>& x, const dual<N>& y) { return fmin(x, y); }
+template <int N> inline dual<N> max(const dual<N>& x, const dual<N>& y) { return fmax(x, y); }
+template <int N> inline dual<N> min(const dual<N>& x, double y) { return fmin(x, y); }
+template <int N> inline dual<N> max(const dual<N>& x, double y) { return fmax(x, y); }
+template <int N> inline dual<N> min(double x, const dual<N>& y) { return fmin(x, y); }
+template <int N> inline dual<N> max(double x, const dual<N>& y) { return fmax(x, y); }
+
+// number of gradient entries carried by a number type, zero for doubles
+template <typename T> struct n_grad { static const int value = 0; };
+template <int N> struct n_grad< dual<N> > { static const int value = N; };
+
+// copy the values of n numbers, and their gradients, into the columns of a column major n x (1 + N)
+// matrix, so that a linear map is applied to the values and the gradients in one matrix product
+inline void pack(const double* x, int n, double* m) {
+      for(int i = 0; i < n; ++i) m[i] = x[i];
+}
+
+template <int N>
+inline void pack(const dual<N>* x, int n, double* m) {
+      for(int i = 0; i < n; ++i) {
+            m[i] = x[i].val;
+            for(int j = 0; j < N; ++j) m[i + (j + 1) * n] = x[i].grad[j];
+      }
+}
+
+// y = base + the product of a linear map with packed numbers, m is the column major n x (1 + N) product
+inline void unpack_affine(const double* m, const double* base, int n, double* y) {
+      for(int i = 0; i < n; ++i) y[i] = base[i] + m[i];
+}
+
+template <int N>
+inline void unpack_affine(const double* m, const double* base, int n, dual<N>* y) {
+      for(int i = 0; i < n; ++i) {
+            y[i].val = base[i] + m[i];
+            for(int j = 0; j < N; ++j) y[i].grad[j] = m[i + (j + 1) * n];
+      }
+}
+
+// copy the values of a vector of duals, and their gradients into the rows of a column major matrix
+template <int N>
+inline void unpack(const dual<N>* y, double* values, double* jacobian) {
+      for(int i = 0; i < N; ++i) {
+            values[i] = y[i].val;
+            for(int j = 0; j < N; ++j) jacobian[i + j * N] = y[i].grad[j];
+      }
+}
+
+}
+
+#endif
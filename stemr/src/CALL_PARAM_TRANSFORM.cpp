@@ -0,0 +1,21 @@
+// [[Rcpp::depends(Rcpp)]]
+#include "stemr_types.h"
+
+using namespace Rcpp;
+
+//' Transform model parameters to or from their estimation scales via XPtr.
+//'
+//' @param dest vector in which to store the transformed parameters
+//' @param orig vector of parameters to be transformed
+//' @param transform_ptr external pointer to the compiled transformation
+//'
+//' @export
+// [[Rcpp::export]]
+void CALL_PARAM_TRANSFORM(Rcpp::NumericVector& dest, const Rcpp::NumericVector& orig, SEXP transform_ptr) {
+
+        Rcpp::XPtr<param_transform_ptr> xpfun(transform_ptr); // Receive the SEXP and put in Xptr
+        param_transform_ptr fun = *xpfun;                     // get function via pointer
+
+        // transform the parameters, dest is modified in place
+        fun(dest.begin(), orig.begin());
+}
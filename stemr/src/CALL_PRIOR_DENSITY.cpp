@@ -0,0 +1,23 @@
+// [[Rcpp::depends(Rcpp)]]
+#include "stemr_types.h"
+
+using namespace Rcpp;
+
+//' Evaluate a compiled prior density via XPtr.
+//'
+//' @param params_nat vector of model parameters on their natural scales
+//' @param params_est vector of model parameters on their estimation scales
+//' @param prior_ptr external pointer to the compiled prior density
+//'
+//' @return log prior density on the estimation scale
+//' @export
+// [[Rcpp::export]]
+double CALL_PRIOR_DENSITY(const Rcpp::NumericVector& params_nat, const Rcpp::NumericVector& params_est,
+                          SEXP prior_ptr) {
+
+        Rcpp::XPtr<prior_density_ptr> xpfun(prior_ptr); // Receive the SEXP and put in Xptr
+        prior_density_ptr fun = *xpfun;                  // get function via pointer
+
+        // evaluate the log prior
+        return fun(params_nat.begin(), params_est.begin());
+}
@@ -39,6 +39,31 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// CALL_PARAM_TRANSFORM
+void CALL_PARAM_TRANSFORM(Rcpp::NumericVector& dest, const Rcpp::NumericVector& orig, SEXP transform_ptr);
+RcppExport SEXP _stemr_CALL_PARAM_TRANSFORM(SEXP destSEXP, SEXP origSEXP, SEXP transform_ptrSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type dest(destSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type orig(origSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type transform_ptr(transform_ptrSEXP);
+    CALL_PARAM_TRANSFORM(dest, orig, transform_ptr);
+    return R_NilValue;
+END_RCPP
+}
+// CALL_PRIOR_DENSITY
+double CALL_PRIOR_DENSITY(const Rcpp::NumericVector& params_nat, const Rcpp::NumericVector& params_est, SEXP prior_ptr);
+RcppExport SEXP _stemr_CALL_PRIOR_DENSITY(SEXP params_natSEXP, SEXP params_estSEXP, SEXP prior_ptrSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type params_nat(params_natSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type params_est(params_estSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type prior_ptr(prior_ptrSEXP);
+    rcpp_result_gen = Rcpp::wrap(CALL_PRIOR_DENSITY(params_nat, params_est, prior_ptr));
+    return rcpp_result_gen;
+END_RCPP
+}
 // CALL_RATE_FCN
 void CALL_RATE_FCN(Rcpp::NumericVector& rates, const Rcpp::LogicalVector& inds, const arma::rowvec& state, const Rcpp::NumericVector& parameters, const Rcpp::NumericVector& constants, const arma::rowvec& tcovar, SEXP rate_ptr);
 RcppExport SEXP _stemr_CALL_RATE_FCN(SEXP ratesSEXP, SEXP indsSEXP, SEXP stateSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovarSEXP, SEXP rate_ptrSEXP) {
@@ -83,6 +108,68 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// rw_structure_band
+arma::mat rw_structure_band(int ntimes, int order);
+RcppExport SEXP _stemr_rw_structure_band(SEXP ntimesSEXP, SEXP orderSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type ntimes(ntimesSEXP);
+    Rcpp::traits::input_parameter< int >::type order(orderSEXP);
+    rcpp_result_gen = Rcpp::wrap(rw_structure_band(ntimes, order));
+    return rcpp_result_gen;
+END_RCPP
+}
+// band_chol
+arma::mat band_chol(const arma::mat& band);
+RcppExport SEXP _stemr_band_chol(SEXP bandSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type band(bandSEXP);
+    rcpp_result_gen = Rcpp::wrap(band_chol(band));
+    return rcpp_result_gen;
+END_RCPP
+}
+// band_sigma_ref
+double band_sigma_ref(const arma::mat& band, const arma::mat& kern);
+RcppExport SEXP _stemr_band_sigma_ref(SEXP bandSEXP, SEXP kernSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type band(bandSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type kern(kernSEXP);
+    rcpp_result_gen = Rcpp::wrap(band_sigma_ref(band, kern));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rgmrf_rw
+arma::vec rgmrf_rw(int ntimes, int order, double precision);
+RcppExport SEXP _stemr_rgmrf_rw(SEXP ntimesSEXP, SEXP orderSEXP, SEXP precisionSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type ntimes(ntimesSEXP);
+    Rcpp::traits::input_parameter< int >::type order(orderSEXP);
+    Rcpp::traits::input_parameter< double >::type precision(precisionSEXP);
+    rcpp_result_gen = Rcpp::wrap(rgmrf_rw(ntimes, order, precision));
+    return rcpp_result_gen;
+END_RCPP
+}
+// dgmrf_band
+double dgmrf_band(const arma::vec& x, const arma::mat& band, double precision, int rank);
+RcppExport SEXP _stemr_dgmrf_band(SEXP xSEXP, SEXP bandSEXP, SEXP precisionSEXP, SEXP rankSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::vec& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type band(bandSEXP);
+    Rcpp::traits::input_parameter< double >::type precision(precisionSEXP);
+    Rcpp::traits::input_parameter< int >::type rank(rankSEXP);
+    rcpp_result_gen = Rcpp::wrap(dgmrf_band(x, band, precision, rank));
+    return rcpp_result_gen;
+END_RCPP
+}
 // build_census_path
 arma::mat build_census_path(Rcpp::NumericMatrix& path, Rcpp::NumericVector& census_times, Rcpp::IntegerVector& census_columns);
 RcppExport SEXP _stemr_build_census_path(SEXP pathSEXP, SEXP census_timesSEXP, SEXP census_columnsSEXP) {
@@ -96,6 +183,47 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// census_index_map
+arma::uvec census_index_map(const Rcpp::NumericVector& path_times, const Rcpp::NumericVector& census_times, bool all_inside);
+RcppExport SEXP _stemr_census_index_map(SEXP path_timesSEXP, SEXP census_timesSEXP, SEXP all_insideSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type path_times(path_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type census_times(census_timesSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_inside(all_insideSEXP);
+    rcpp_result_gen = Rcpp::wrap(census_index_map(path_times, census_times, all_inside));
+    return rcpp_result_gen;
+END_RCPP
+}
+// census_path_cached
+arma::mat census_path_cached(const arma::mat& path, const Rcpp::NumericVector& census_times, const arma::uvec& census_inds, const Rcpp::IntegerVector& census_columns);
+RcppExport SEXP _stemr_census_path_cached(SEXP pathSEXP, SEXP census_timesSEXP, SEXP census_indsSEXP, SEXP census_columnsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type census_times(census_timesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type census_inds(census_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_columns(census_columnsSEXP);
+    rcpp_result_gen = Rcpp::wrap(census_path_cached(path, census_times, census_inds, census_columns));
+    return rcpp_result_gen;
+END_RCPP
+}
+// census_path_incidence
+arma::mat census_path_incidence(const arma::mat& path, const Rcpp::NumericVector& census_times, const Rcpp::IntegerVector& census_columns, const Rcpp::IntegerVector& incidence_codes);
+RcppExport SEXP _stemr_census_path_incidence(SEXP pathSEXP, SEXP census_timesSEXP, SEXP census_columnsSEXP, SEXP incidence_codesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type census_times(census_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_columns(census_columnsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type incidence_codes(incidence_codesSEXP);
+    rcpp_result_gen = Rcpp::wrap(census_path_incidence(path, census_times, census_columns, incidence_codes));
+    return rcpp_result_gen;
+END_RCPP
+}
 // census_incidence
 arma::mat census_incidence(const arma::mat& incid_mat, const arma::vec& census_times, const arma::uvec& interval_inds);
 RcppExport SEXP _stemr_census_incidence(SEXP incid_matSEXP, SEXP census_timesSEXP, SEXP interval_indsSEXP) {
@@ -110,8 +238,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // census_lna
-void census_lna(const arma::mat& path, arma::mat& census_path, const arma::uvec& census_inds, const arma::uvec& lna_event_inds, const arma::mat& flow_matrix_lna, bool do_prevalence, const arma::rowvec& init_state, const arma::mat& lna_pars, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers);
-RcppExport SEXP _stemr_census_lna(SEXP pathSEXP, SEXP census_pathSEXP, SEXP census_indsSEXP, SEXP lna_event_indsSEXP, SEXP flow_matrix_lnaSEXP, SEXP do_prevalenceSEXP, SEXP init_stateSEXP, SEXP lna_parsSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP) {
+void census_lna(const arma::mat& path, arma::mat& census_path, const arma::uvec& census_inds, const arma::uvec& lna_event_inds, const arma::mat& flow_matrix_lna, bool do_prevalence, const arma::rowvec& init_state, const arma::mat& lna_pars, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, int census_start);
+RcppExport SEXP _stemr_census_lna(SEXP pathSEXP, SEXP census_pathSEXP, SEXP census_indsSEXP, SEXP lna_event_indsSEXP, SEXP flow_matrix_lnaSEXP, SEXP do_prevalenceSEXP, SEXP init_stateSEXP, SEXP lna_parsSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP census_startSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const arma::mat& >::type path(pathSEXP);
@@ -126,10 +254,23 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
     Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
     Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
-    census_lna(path, census_path, census_inds, lna_event_inds, flow_matrix_lna, do_prevalence, init_state, lna_pars, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers);
+    Rcpp::traits::input_parameter< int >::type census_start(census_startSEXP);
+    census_lna(path, census_path, census_inds, lna_event_inds, flow_matrix_lna, do_prevalence, init_state, lna_pars, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, census_start);
     return R_NilValue;
 END_RCPP
 }
+// compute_data_log_lik
+double compute_data_log_lik(const arma::mat& emitmat, const Rcpp::List& obs_layout);
+RcppExport SEXP _stemr_compute_data_log_lik(SEXP emitmatSEXP, SEXP obs_layoutSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    rcpp_result_gen = Rcpp::wrap(compute_data_log_lik(emitmat, obs_layout));
+    return rcpp_result_gen;
+END_RCPP
+}
 // compute_incidence
 void compute_incidence(arma::mat& censusmat, arma::uvec& col_inds, Rcpp::List& row_inds);
 RcppExport SEXP _stemr_compute_incidence(SEXP censusmatSEXP, SEXP col_indsSEXP, SEXP row_indsSEXP) {
@@ -203,13 +344,14 @@ BEGIN_RCPP
 END_RCPP
 }
 // increment_elem
-void increment_elem(arma::vec& vec, int ind);
-RcppExport SEXP _stemr_increment_elem(SEXP vecSEXP, SEXP indSEXP) {
+void increment_elem(arma::vec& vec, int ind, double amount);
+RcppExport SEXP _stemr_increment_elem(SEXP vecSEXP, SEXP indSEXP, SEXP amountSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< arma::vec& >::type vec(vecSEXP);
     Rcpp::traits::input_parameter< int >::type ind(indSEXP);
-    increment_elem(vec, ind);
+    Rcpp::traits::input_parameter< double >::type amount(amountSEXP);
+    increment_elem(vec, ind, amount);
     return R_NilValue;
 END_RCPP
 }
@@ -361,31 +503,31 @@ BEGIN_RCPP
 END_RCPP
 }
 // evaluate_d_measure
-void evaluate_d_measure(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat, const Rcpp::NumericMatrix& statemat, const Rcpp::LogicalMatrix& measproc_indmat, const Rcpp::NumericVector& parameters, const Rcpp::NumericVector& constants, const Rcpp::NumericMatrix& tcovar_censusmat, SEXP d_meas_ptr);
-RcppExport SEXP _stemr_evaluate_d_measure(SEXP emitmatSEXP, SEXP obsmatSEXP, SEXP statematSEXP, SEXP measproc_indmatSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovar_censusmatSEXP, SEXP d_meas_ptrSEXP) {
+void evaluate_d_measure(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat, const Rcpp::NumericMatrix& statemat, const Rcpp::List& obs_layout, const Rcpp::NumericVector& parameters, const Rcpp::NumericVector& constants, const Rcpp::NumericMatrix& tcovar_censusmat, SEXP d_meas_ptr);
+RcppExport SEXP _stemr_evaluate_d_measure(SEXP emitmatSEXP, SEXP obsmatSEXP, SEXP statematSEXP, SEXP obs_layoutSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovar_censusmatSEXP, SEXP d_meas_ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type obsmat(obsmatSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type statemat(statematSEXP);
-    Rcpp::traits::input_parameter< const Rcpp::LogicalMatrix& >::type measproc_indmat(measproc_indmatSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type parameters(parametersSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type constants(constantsSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type tcovar_censusmat(tcovar_censusmatSEXP);
     Rcpp::traits::input_parameter< SEXP >::type d_meas_ptr(d_meas_ptrSEXP);
-    evaluate_d_measure(emitmat, obsmat, statemat, measproc_indmat, parameters, constants, tcovar_censusmat, d_meas_ptr);
+    evaluate_d_measure(emitmat, obsmat, statemat, obs_layout, parameters, constants, tcovar_censusmat, d_meas_ptr);
     return R_NilValue;
 END_RCPP
 }
 // evaluate_d_measure_LNA
-void evaluate_d_measure_LNA(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat, const Rcpp::NumericMatrix& censusmat, const Rcpp::LogicalMatrix& measproc_indmat, const Rcpp::NumericMatrix& lna_parameters, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, Rcpp::NumericVector& lna_param_vec, SEXP d_meas_ptr);
-RcppExport SEXP _stemr_evaluate_d_measure_LNA(SEXP emitmatSEXP, SEXP obsmatSEXP, SEXP censusmatSEXP, SEXP measproc_indmatSEXP, SEXP lna_parametersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP lna_param_vecSEXP, SEXP d_meas_ptrSEXP) {
+void evaluate_d_measure_LNA(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat, const Rcpp::NumericMatrix& censusmat, const Rcpp::List& obs_layout, const Rcpp::NumericMatrix& lna_parameters, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, Rcpp::NumericVector& lna_param_vec, SEXP d_meas_ptr, int row_start);
+RcppExport SEXP _stemr_evaluate_d_measure_LNA(SEXP emitmatSEXP, SEXP obsmatSEXP, SEXP censusmatSEXP, SEXP obs_layoutSEXP, SEXP lna_parametersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP lna_param_vecSEXP, SEXP d_meas_ptrSEXP, SEXP row_startSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type obsmat(obsmatSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
-    Rcpp::traits::input_parameter< const Rcpp::LogicalMatrix& >::type measproc_indmat(measproc_indmatSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type lna_parameters(lna_parametersSEXP);
     Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
     Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_const_inds(lna_const_indsSEXP);
@@ -394,10 +536,137 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
     Rcpp::traits::input_parameter< SEXP >::type d_meas_ptr(d_meas_ptrSEXP);
-    evaluate_d_measure_LNA(emitmat, obsmat, censusmat, measproc_indmat, lna_parameters, lna_param_inds, lna_const_inds, lna_tcovar_inds, param_update_inds, census_indices, lna_param_vec, d_meas_ptr);
+    Rcpp::traits::input_parameter< int >::type row_start(row_startSEXP);
+    evaluate_d_measure_LNA(emitmat, obsmat, censusmat, obs_layout, lna_parameters, lna_param_inds, lna_const_inds, lna_tcovar_inds, param_update_inds, census_indices, lna_param_vec, d_meas_ptr, row_start);
+    return R_NilValue;
+END_RCPP
+}
+// factor_slice_update_lna
+void factor_slice_update_lna(Rcpp::NumericVector& model_params_est, Rcpp::NumericVector& model_params_nat, Rcpp::NumericVector& params_prop_est, Rcpp::NumericVector& params_prop_nat, const arma::vec& interval_widths, arma::vec& n_contractions_afss, arma::vec& n_expansions_afss, arma::vec& c_contractions_afss, arma::vec& c_expansions_afss, const arma::mat& slice_eigenvecs, const Rcpp::NumericVector& slice_probs, int n_afss_updates, const Rcpp::List& path, Rcpp::NumericMatrix& pathmat_prop, const Rcpp::NumericMatrix& data, const Rcpp::List& priors, Rcpp::NumericVector& params_logprior_cur, Rcpp::NumericMatrix& lna_params_cur, Rcpp::NumericVector& lna_param_vec, SEXP tparam, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& lna_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::IntegerVector& lna_initdist_inds, const arma::uvec& path_par_inds, const Rcpp::LogicalVector& param_update_inds, const arma::uvec& lna_event_inds, const Rcpp::IntegerVector& census_indices, const Rcpp::List& obs_layout, arma::vec& svd_d, arma::mat& svd_U, arma::mat& svd_V, SEXP lna_pointer, SEXP lna_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, SEXP slice_batch);
+RcppExport SEXP _stemr_factor_slice_update_lna(SEXP model_params_estSEXP, SEXP model_params_natSEXP, SEXP params_prop_estSEXP, SEXP params_prop_natSEXP, SEXP interval_widthsSEXP, SEXP n_contractions_afssSEXP, SEXP n_expansions_afssSEXP, SEXP c_contractions_afssSEXP, SEXP c_expansions_afssSEXP, SEXP slice_eigenvecsSEXP, SEXP slice_probsSEXP, SEXP n_afss_updatesSEXP, SEXP pathSEXP, SEXP pathmat_propSEXP, SEXP dataSEXP, SEXP priorsSEXP, SEXP params_logprior_curSEXP, SEXP lna_params_curSEXP, SEXP lna_param_vecSEXP, SEXP tparamSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP lna_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP lna_initdist_indsSEXP, SEXP path_par_indsSEXP, SEXP param_update_indsSEXP, SEXP lna_event_indsSEXP, SEXP census_indicesSEXP, SEXP obs_layoutSEXP, SEXP svd_dSEXP, SEXP svd_USEXP, SEXP svd_VSEXP, SEXP lna_pointerSEXP, SEXP lna_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP slice_batchSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_est(model_params_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_nat(model_params_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_est(params_prop_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_nat(params_prop_natSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type interval_widths(interval_widthsSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_contractions_afss(n_contractions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_expansions_afss(n_expansions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type c_contractions_afss(c_contractions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type c_expansions_afss(c_expansions_afssSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type slice_eigenvecs(slice_eigenvecsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type slice_probs(slice_probsSEXP);
+    Rcpp::traits::input_parameter< int >::type n_afss_updates(n_afss_updatesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_logprior_cur(params_logprior_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type lna_params_cur(lna_params_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type lna_times(lna_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_const_inds(lna_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_tcovar_inds(lna_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_initdist_inds(lna_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type path_par_inds(path_par_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type lna_event_inds(lna_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type svd_d(svd_dSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_U(svd_USEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_V(svd_VSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_pointer(lna_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_set_pars_pointer(lna_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type slice_batch(slice_batchSEXP);
+    factor_slice_update_lna(model_params_est, model_params_nat, params_prop_est, params_prop_nat, interval_widths, n_contractions_afss, n_expansions_afss, c_contractions_afss, c_expansions_afss, slice_eigenvecs, slice_probs, n_afss_updates, path, pathmat_prop, data, priors, params_logprior_cur, lna_params_cur, lna_param_vec, tparam, censusmat, emitmat, flow_matrix, stoich_matrix, lna_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, lna_param_inds, lna_const_inds, lna_tcovar_inds, lna_initdist_inds, path_par_inds, param_update_inds, lna_event_inds, census_indices, obs_layout, svd_d, svd_U, svd_V, lna_pointer, lna_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, slice_batch);
+    return R_NilValue;
+END_RCPP
+}
+// factor_slice_update_ode
+void factor_slice_update_ode(Rcpp::NumericVector& model_params_est, Rcpp::NumericVector& model_params_nat, Rcpp::NumericVector& params_prop_est, Rcpp::NumericVector& params_prop_nat, const arma::vec& interval_widths, arma::vec& n_contractions_afss, arma::vec& n_expansions_afss, arma::vec& c_contractions_afss, arma::vec& c_expansions_afss, const arma::mat& slice_eigenvecs, const Rcpp::NumericVector& slice_probs, int n_afss_updates, const Rcpp::List& path, Rcpp::NumericMatrix& pathmat_prop, const Rcpp::NumericMatrix& data, const Rcpp::List& priors, Rcpp::NumericVector& params_logprior_cur, Rcpp::NumericMatrix& ode_params_cur, Rcpp::NumericVector& ode_param_vec, SEXP tparam, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& ode_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_const_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const Rcpp::IntegerVector& ode_initdist_inds, const arma::uvec& path_par_inds, SEXP ode_cache, const Rcpp::LogicalVector& param_update_inds, const arma::uvec& ode_event_inds, const Rcpp::IntegerVector& census_indices, const Rcpp::List& obs_layout, SEXP ode_pointer, SEXP ode_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, SEXP slice_batch);
+RcppExport SEXP _stemr_factor_slice_update_ode(SEXP model_params_estSEXP, SEXP model_params_natSEXP, SEXP params_prop_estSEXP, SEXP params_prop_natSEXP, SEXP interval_widthsSEXP, SEXP n_contractions_afssSEXP, SEXP n_expansions_afssSEXP, SEXP c_contractions_afssSEXP, SEXP c_expansions_afssSEXP, SEXP slice_eigenvecsSEXP, SEXP slice_probsSEXP, SEXP n_afss_updatesSEXP, SEXP pathSEXP, SEXP pathmat_propSEXP, SEXP dataSEXP, SEXP priorsSEXP, SEXP params_logprior_curSEXP, SEXP ode_params_curSEXP, SEXP ode_param_vecSEXP, SEXP tparamSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP ode_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP ode_param_indsSEXP, SEXP ode_const_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP ode_initdist_indsSEXP, SEXP path_par_indsSEXP, SEXP ode_cacheSEXP, SEXP param_update_indsSEXP, SEXP ode_event_indsSEXP, SEXP census_indicesSEXP, SEXP obs_layoutSEXP, SEXP ode_pointerSEXP, SEXP ode_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP slice_batchSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_est(model_params_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_nat(model_params_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_est(params_prop_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_nat(params_prop_natSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type interval_widths(interval_widthsSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_contractions_afss(n_contractions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_expansions_afss(n_expansions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type c_contractions_afss(c_contractions_afssSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type c_expansions_afss(c_expansions_afssSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type slice_eigenvecs(slice_eigenvecsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type slice_probs(slice_probsSEXP);
+    Rcpp::traits::input_parameter< int >::type n_afss_updates(n_afss_updatesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_logprior_cur(params_logprior_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type ode_params_cur(ode_params_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_param_vec(ode_param_vecSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_const_inds(ode_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_initdist_inds(ode_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type path_par_inds(path_par_indsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type ode_event_inds(ode_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_set_pars_pointer(ode_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type slice_batch(slice_batchSEXP);
+    factor_slice_update_ode(model_params_est, model_params_nat, params_prop_est, params_prop_nat, interval_widths, n_contractions_afss, n_expansions_afss, c_contractions_afss, c_expansions_afss, slice_eigenvecs, slice_probs, n_afss_updates, path, pathmat_prop, data, priors, params_logprior_cur, ode_params_cur, ode_param_vec, tparam, censusmat, emitmat, flow_matrix, stoich_matrix, ode_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds, path_par_inds, ode_cache, param_update_inds, ode_event_inds, census_indices, obs_layout, ode_pointer, ode_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, slice_batch);
     return R_NilValue;
 END_RCPP
 }
+// find_dirty_range
+int find_dirty_range(arma::mat& path_ref, const arma::mat& path, arma::mat& pars_ref, const arma::mat& lna_pars, const arma::uvec& census_inds, bool reset);
+RcppExport SEXP _stemr_find_dirty_range(SEXP path_refSEXP, SEXP pathSEXP, SEXP pars_refSEXP, SEXP lna_parsSEXP, SEXP census_indsSEXP, SEXP resetSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::mat& >::type path_ref(path_refSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type pars_ref(pars_refSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type lna_pars(lna_parsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type census_inds(census_indsSEXP);
+    Rcpp::traits::input_parameter< bool >::type reset(resetSEXP);
+    rcpp_result_gen = Rcpp::wrap(find_dirty_range(path_ref, path, pars_ref, lna_pars, census_inds, reset));
+    return rcpp_result_gen;
+END_RCPP
+}
 // find_interval
 Rcpp::IntegerVector find_interval(Rcpp::NumericVector& x, Rcpp::NumericVector& breaks, bool rightmost_closed, bool all_inside);
 RcppExport SEXP _stemr_find_interval(SEXP xSEXP, SEXP breaksSEXP, SEXP rightmost_closedSEXP, SEXP all_insideSEXP) {
@@ -424,6 +693,211 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// hit_and_run_slice_update_lna
+void hit_and_run_slice_update_lna(Rcpp::NumericVector& model_params_est, Rcpp::NumericVector& model_params_nat, Rcpp::NumericVector& params_prop_est, Rcpp::NumericVector& params_prop_nat, arma::vec& har_direction, arma::vec& mvn_direction, arma::vec& mvnss_propvec, const arma::uvec& param_inds_Cpp, const arma::mat& kernel_cov_chol, double nugget, double bracket_width, arma::vec& n_expansions, arma::vec& n_contractions, int n_updates, const Rcpp::List& path, Rcpp::NumericMatrix& pathmat_prop, const Rcpp::NumericMatrix& data, const Rcpp::List& priors, Rcpp::NumericVector& params_logprior_cur, Rcpp::NumericMatrix& lna_params_cur, Rcpp::NumericVector& lna_param_vec, SEXP tparam, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& lna_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::IntegerVector& lna_initdist_inds, const arma::uvec& path_par_inds, const Rcpp::LogicalVector& param_update_inds, const arma::uvec& lna_event_inds, const Rcpp::IntegerVector& census_indices, const Rcpp::List& obs_layout, arma::vec& svd_d, arma::mat& svd_U, arma::mat& svd_V, SEXP lna_pointer, SEXP lna_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, SEXP slice_batch);
+RcppExport SEXP _stemr_hit_and_run_slice_update_lna(SEXP model_params_estSEXP, SEXP model_params_natSEXP, SEXP params_prop_estSEXP, SEXP params_prop_natSEXP, SEXP har_directionSEXP, SEXP mvn_directionSEXP, SEXP mvnss_propvecSEXP, SEXP param_inds_CppSEXP, SEXP kernel_cov_cholSEXP, SEXP nuggetSEXP, SEXP bracket_widthSEXP, SEXP n_expansionsSEXP, SEXP n_contractionsSEXP, SEXP n_updatesSEXP, SEXP pathSEXP, SEXP pathmat_propSEXP, SEXP dataSEXP, SEXP priorsSEXP, SEXP params_logprior_curSEXP, SEXP lna_params_curSEXP, SEXP lna_param_vecSEXP, SEXP tparamSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP lna_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP lna_initdist_indsSEXP, SEXP path_par_indsSEXP, SEXP param_update_indsSEXP, SEXP lna_event_indsSEXP, SEXP census_indicesSEXP, SEXP obs_layoutSEXP, SEXP svd_dSEXP, SEXP svd_USEXP, SEXP svd_VSEXP, SEXP lna_pointerSEXP, SEXP lna_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP slice_batchSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_est(model_params_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_nat(model_params_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_est(params_prop_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_nat(params_prop_natSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type har_direction(har_directionSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type mvn_direction(mvn_directionSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type mvnss_propvec(mvnss_propvecSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type param_inds_Cpp(param_inds_CppSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type kernel_cov_chol(kernel_cov_cholSEXP);
+    Rcpp::traits::input_parameter< double >::type nugget(nuggetSEXP);
+    Rcpp::traits::input_parameter< double >::type bracket_width(bracket_widthSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_expansions(n_expansionsSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_contractions(n_contractionsSEXP);
+    Rcpp::traits::input_parameter< int >::type n_updates(n_updatesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_logprior_cur(params_logprior_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type lna_params_cur(lna_params_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type lna_times(lna_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_const_inds(lna_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_tcovar_inds(lna_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_initdist_inds(lna_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type path_par_inds(path_par_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type lna_event_inds(lna_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type svd_d(svd_dSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_U(svd_USEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_V(svd_VSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_pointer(lna_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_set_pars_pointer(lna_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type slice_batch(slice_batchSEXP);
+    hit_and_run_slice_update_lna(model_params_est, model_params_nat, params_prop_est, params_prop_nat, har_direction, mvn_direction, mvnss_propvec, param_inds_Cpp, kernel_cov_chol, nugget, bracket_width, n_expansions, n_contractions, n_updates, path, pathmat_prop, data, priors, params_logprior_cur, lna_params_cur, lna_param_vec, tparam, censusmat, emitmat, flow_matrix, stoich_matrix, lna_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, lna_param_inds, lna_const_inds, lna_tcovar_inds, lna_initdist_inds, path_par_inds, param_update_inds, lna_event_inds, census_indices, obs_layout, svd_d, svd_U, svd_V, lna_pointer, lna_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, slice_batch);
+    return R_NilValue;
+END_RCPP
+}
+// hit_and_run_slice_update_ode
+void hit_and_run_slice_update_ode(Rcpp::NumericVector& model_params_est, Rcpp::NumericVector& model_params_nat, Rcpp::NumericVector& params_prop_est, Rcpp::NumericVector& params_prop_nat, arma::vec& har_direction, arma::vec& mvn_direction, arma::vec& mvnss_propvec, const arma::uvec& param_inds_Cpp, const arma::mat& kernel_cov_chol, double nugget, double bracket_width, arma::vec& n_expansions, arma::vec& n_contractions, int n_updates, const Rcpp::List& path, Rcpp::NumericMatrix& pathmat_prop, const Rcpp::NumericMatrix& data, const Rcpp::List& priors, Rcpp::NumericVector& params_logprior_cur, Rcpp::NumericMatrix& ode_params_cur, Rcpp::NumericVector& ode_param_vec, SEXP tparam, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& ode_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_const_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const Rcpp::IntegerVector& ode_initdist_inds, const arma::uvec& path_par_inds, SEXP ode_cache, const Rcpp::LogicalVector& param_update_inds, const arma::uvec& ode_event_inds, const Rcpp::IntegerVector& census_indices, const Rcpp::List& obs_layout, SEXP ode_pointer, SEXP ode_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, SEXP slice_batch);
+RcppExport SEXP _stemr_hit_and_run_slice_update_ode(SEXP model_params_estSEXP, SEXP model_params_natSEXP, SEXP params_prop_estSEXP, SEXP params_prop_natSEXP, SEXP har_directionSEXP, SEXP mvn_directionSEXP, SEXP mvnss_propvecSEXP, SEXP param_inds_CppSEXP, SEXP kernel_cov_cholSEXP, SEXP nuggetSEXP, SEXP bracket_widthSEXP, SEXP n_expansionsSEXP, SEXP n_contractionsSEXP, SEXP n_updatesSEXP, SEXP pathSEXP, SEXP pathmat_propSEXP, SEXP dataSEXP, SEXP priorsSEXP, SEXP params_logprior_curSEXP, SEXP ode_params_curSEXP, SEXP ode_param_vecSEXP, SEXP tparamSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP ode_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP ode_param_indsSEXP, SEXP ode_const_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP ode_initdist_indsSEXP, SEXP path_par_indsSEXP, SEXP ode_cacheSEXP, SEXP param_update_indsSEXP, SEXP ode_event_indsSEXP, SEXP census_indicesSEXP, SEXP obs_layoutSEXP, SEXP ode_pointerSEXP, SEXP ode_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP slice_batchSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_est(model_params_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_nat(model_params_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_est(params_prop_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_nat(params_prop_natSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type har_direction(har_directionSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type mvn_direction(mvn_directionSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type mvnss_propvec(mvnss_propvecSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type param_inds_Cpp(param_inds_CppSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type kernel_cov_chol(kernel_cov_cholSEXP);
+    Rcpp::traits::input_parameter< double >::type nugget(nuggetSEXP);
+    Rcpp::traits::input_parameter< double >::type bracket_width(bracket_widthSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_expansions(n_expansionsSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type n_contractions(n_contractionsSEXP);
+    Rcpp::traits::input_parameter< int >::type n_updates(n_updatesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_logprior_cur(params_logprior_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type ode_params_cur(ode_params_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_param_vec(ode_param_vecSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_const_inds(ode_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_initdist_inds(ode_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type path_par_inds(path_par_indsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type ode_event_inds(ode_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_set_pars_pointer(ode_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type slice_batch(slice_batchSEXP);
+    hit_and_run_slice_update_ode(model_params_est, model_params_nat, params_prop_est, params_prop_nat, har_direction, mvn_direction, mvnss_propvec, param_inds_Cpp, kernel_cov_chol, nugget, bracket_width, n_expansions, n_contractions, n_updates, path, pathmat_prop, data, priors, params_logprior_cur, ode_params_cur, ode_param_vec, tparam, censusmat, emitmat, flow_matrix, stoich_matrix, ode_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds, path_par_inds, ode_cache, param_update_inds, ode_event_inds, census_indices, obs_layout, ode_pointer, ode_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, slice_batch);
+    return R_NilValue;
+END_RCPP
+}
+// initdist_ess_update_lna
+void initdist_ess_update_lna(const Rcpp::List& initdist_objects, Rcpp::NumericVector& init_volumes_cur, Rcpp::NumericVector& init_volumes_prop, const Rcpp::List& path_cur, const Rcpp::NumericMatrix& data, Rcpp::NumericMatrix& lna_parameters, Rcpp::NumericVector& lna_param_vec, const Rcpp::List& tparam, Rcpp::NumericMatrix& pathmat_prop, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& lna_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::IntegerVector& lna_initdist_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, const arma::uvec& lna_event_inds, const Rcpp::List& obs_layout, arma::vec& svd_d, arma::mat& svd_U, arma::mat& svd_V, SEXP lna_pointer, SEXP lna_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, Rcpp::NumericVector& initdist_steps, Rcpp::NumericVector& initdist_angle, double initdist_bracket_width, int n_initdist_updates);
+RcppExport SEXP _stemr_initdist_ess_update_lna(SEXP initdist_objectsSEXP, SEXP init_volumes_curSEXP, SEXP init_volumes_propSEXP, SEXP path_curSEXP, SEXP dataSEXP, SEXP lna_parametersSEXP, SEXP lna_param_vecSEXP, SEXP tparamSEXP, SEXP pathmat_propSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP lna_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP lna_initdist_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP lna_event_indsSEXP, SEXP obs_layoutSEXP, SEXP svd_dSEXP, SEXP svd_USEXP, SEXP svd_VSEXP, SEXP lna_pointerSEXP, SEXP lna_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP initdist_stepsSEXP, SEXP initdist_angleSEXP, SEXP initdist_bracket_widthSEXP, SEXP n_initdist_updatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type initdist_objects(initdist_objectsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type init_volumes_cur(init_volumes_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type init_volumes_prop(init_volumes_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path_cur(path_curSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type lna_parameters(lna_parametersSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type lna_times(lna_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_const_inds(lna_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_tcovar_inds(lna_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_initdist_inds(lna_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type lna_event_inds(lna_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type svd_d(svd_dSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_U(svd_USEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_V(svd_VSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_pointer(lna_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_set_pars_pointer(lna_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type initdist_steps(initdist_stepsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type initdist_angle(initdist_angleSEXP);
+    Rcpp::traits::input_parameter< double >::type initdist_bracket_width(initdist_bracket_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type n_initdist_updates(n_initdist_updatesSEXP);
+    initdist_ess_update_lna(initdist_objects, init_volumes_cur, init_volumes_prop, path_cur, data, lna_parameters, lna_param_vec, tparam, pathmat_prop, censusmat, emitmat, flow_matrix, stoich_matrix, lna_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, lna_param_inds, lna_const_inds, lna_tcovar_inds, lna_initdist_inds, param_update_inds, census_indices, lna_event_inds, obs_layout, svd_d, svd_U, svd_V, lna_pointer, lna_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, initdist_steps, initdist_angle, initdist_bracket_width, n_initdist_updates);
+    return R_NilValue;
+END_RCPP
+}
+// initdist_ess_update_ode
+void initdist_ess_update_ode(const Rcpp::List& initdist_objects, Rcpp::NumericVector& init_volumes_cur, Rcpp::NumericVector& init_volumes_prop, const Rcpp::List& path_cur, const Rcpp::NumericMatrix& data, Rcpp::NumericMatrix& ode_parameters, Rcpp::NumericVector& ode_param_vec, const Rcpp::List& tparam, Rcpp::NumericMatrix& pathmat_prop, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& ode_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_const_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const Rcpp::IntegerVector& ode_initdist_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, const arma::uvec& ode_event_inds, const Rcpp::List& obs_layout, SEXP ode_pointer, SEXP ode_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, Rcpp::NumericVector& initdist_steps, Rcpp::NumericVector& initdist_angle, double initdist_bracket_width, int n_initdist_updates);
+RcppExport SEXP _stemr_initdist_ess_update_ode(SEXP initdist_objectsSEXP, SEXP init_volumes_curSEXP, SEXP init_volumes_propSEXP, SEXP path_curSEXP, SEXP dataSEXP, SEXP ode_parametersSEXP, SEXP ode_param_vecSEXP, SEXP tparamSEXP, SEXP pathmat_propSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP ode_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP ode_param_indsSEXP, SEXP ode_const_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP ode_initdist_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP ode_event_indsSEXP, SEXP obs_layoutSEXP, SEXP ode_pointerSEXP, SEXP ode_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP initdist_stepsSEXP, SEXP initdist_angleSEXP, SEXP initdist_bracket_widthSEXP, SEXP n_initdist_updatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type initdist_objects(initdist_objectsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type init_volumes_cur(init_volumes_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type init_volumes_prop(init_volumes_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path_cur(path_curSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type ode_parameters(ode_parametersSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_param_vec(ode_param_vecSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_const_inds(ode_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_initdist_inds(ode_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type ode_event_inds(ode_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_set_pars_pointer(ode_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type initdist_steps(initdist_stepsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type initdist_angle(initdist_angleSEXP);
+    Rcpp::traits::input_parameter< double >::type initdist_bracket_width(initdist_bracket_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type n_initdist_updates(n_initdist_updatesSEXP);
+    initdist_ess_update_ode(initdist_objects, init_volumes_cur, init_volumes_prop, path_cur, data, ode_parameters, ode_param_vec, tparam, pathmat_prop, censusmat, emitmat, flow_matrix, stoich_matrix, ode_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds, param_update_inds, census_indices, ode_event_inds, obs_layout, ode_pointer, ode_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, initdist_steps, initdist_angle, initdist_bracket_width, n_initdist_updates);
+    return R_NilValue;
+END_RCPP
+}
 // insert_tparam
 void insert_tparam(arma::mat& tcovar, const arma::vec& values, int col_ind, const arma::uvec& tpar_inds);
 RcppExport SEXP _stemr_insert_tparam(SEXP tcovarSEXP, SEXP valuesSEXP, SEXP col_indSEXP, SEXP tpar_indsSEXP) {
@@ -461,6 +935,57 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// chol_update
+void chol_update(arma::mat& R, arma::vec x);
+RcppExport SEXP _stemr_chol_update(SEXP RSEXP, SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::mat& >::type R(RSEXP);
+    Rcpp::traits::input_parameter< arma::vec >::type x(xSEXP);
+    chol_update(R, x);
+    return R_NilValue;
+END_RCPP
+}
+// update_kernel_cov
+void update_kernel_cov(arma::vec& kernel_mean, arma::mat& kernel_cov, arma::mat& kernel_chol, arma::vec& kernel_resid, const arma::vec& params_est, double adaptation);
+RcppExport SEXP _stemr_update_kernel_cov(SEXP kernel_meanSEXP, SEXP kernel_covSEXP, SEXP kernel_cholSEXP, SEXP kernel_residSEXP, SEXP params_estSEXP, SEXP adaptationSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::vec& >::type kernel_mean(kernel_meanSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type kernel_cov(kernel_covSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type kernel_chol(kernel_cholSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type kernel_resid(kernel_residSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type params_est(params_estSEXP);
+    Rcpp::traits::input_parameter< double >::type adaptation(adaptationSEXP);
+    update_kernel_cov(kernel_mean, kernel_cov, kernel_chol, kernel_resid, params_est, adaptation);
+    return R_NilValue;
+END_RCPP
+}
+// track_factors
+void track_factors(arma::vec& slice_eigenvals, const arma::mat& slice_eigenvecs, const arma::vec& kernel_resid, double adaptation);
+RcppExport SEXP _stemr_track_factors(SEXP slice_eigenvalsSEXP, SEXP slice_eigenvecsSEXP, SEXP kernel_residSEXP, SEXP adaptationSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::vec& >::type slice_eigenvals(slice_eigenvalsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type slice_eigenvecs(slice_eigenvecsSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type kernel_resid(kernel_residSEXP);
+    Rcpp::traits::input_parameter< double >::type adaptation(adaptationSEXP);
+    track_factors(slice_eigenvals, slice_eigenvecs, kernel_resid, adaptation);
+    return R_NilValue;
+END_RCPP
+}
+// update_factors_subspace
+void update_factors_subspace(arma::vec& slice_eigenvals, arma::mat& slice_eigenvecs, const arma::mat& kernel_cov);
+RcppExport SEXP _stemr_update_factors_subspace(SEXP slice_eigenvalsSEXP, SEXP slice_eigenvecsSEXP, SEXP kernel_covSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::vec& >::type slice_eigenvals(slice_eigenvalsSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type slice_eigenvecs(slice_eigenvecsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type kernel_cov(kernel_covSEXP);
+    update_factors_subspace(slice_eigenvals, slice_eigenvecs, kernel_cov);
+    return R_NilValue;
+END_RCPP
+}
 // lna_incid2prev
 arma::mat lna_incid2prev(const arma::mat& path, const arma::mat& flow_matrix, const arma::rowvec& init_state, const arma::mat& forcing_matrix, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers);
 RcppExport SEXP _stemr_lna_incid2prev(SEXP pathSEXP, SEXP flow_matrixSEXP, SEXP init_stateSEXP, SEXP forcing_matrixSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP) {
@@ -508,6 +1033,42 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// map_draws_2_lna_census
+void map_draws_2_lna_census(arma::mat& pathmat, const arma::mat& draws, const arma::rowvec& lna_times, const Rcpp::NumericMatrix& lna_pars, Rcpp::NumericVector& lna_param_vec, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const int init_start, const Rcpp::LogicalVector& param_update_inds, const arma::mat& stoich_matrix, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, arma::vec& svd_d, arma::mat& svd_U, arma::mat& svd_V, double step_size, SEXP lna_pointer, SEXP set_pars_pointer, arma::mat& census_path, const arma::uvec& census_inds, const arma::uvec& lna_event_inds, const arma::mat& flow_matrix_lna, bool do_prevalence, const arma::rowvec& init_state, bool store_path);
+RcppExport SEXP _stemr_map_draws_2_lna_census(SEXP pathmatSEXP, SEXP drawsSEXP, SEXP lna_timesSEXP, SEXP lna_parsSEXP, SEXP lna_param_vecSEXP, SEXP lna_param_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP init_startSEXP, SEXP param_update_indsSEXP, SEXP stoich_matrixSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP svd_dSEXP, SEXP svd_USEXP, SEXP svd_VSEXP, SEXP step_sizeSEXP, SEXP lna_pointerSEXP, SEXP set_pars_pointerSEXP, SEXP census_pathSEXP, SEXP census_indsSEXP, SEXP lna_event_indsSEXP, SEXP flow_matrix_lnaSEXP, SEXP do_prevalenceSEXP, SEXP init_stateSEXP, SEXP store_pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::mat& >::type pathmat(pathmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type draws(drawsSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type lna_times(lna_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type lna_pars(lna_parsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_tcovar_inds(lna_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const int >::type init_start(init_startSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type svd_d(svd_dSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_U(svd_USEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_V(svd_VSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_pointer(lna_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type set_pars_pointer(set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type census_path(census_pathSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type census_inds(census_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type lna_event_inds(lna_event_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix_lna(flow_matrix_lnaSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type init_state(init_stateSEXP);
+    Rcpp::traits::input_parameter< bool >::type store_path(store_pathSEXP);
+    map_draws_2_lna_census(pathmat, draws, lna_times, lna_pars, lna_param_vec, lna_param_inds, lna_tcovar_inds, init_start, param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, svd_d, svd_U, svd_V, step_size, lna_pointer, set_pars_pointer, census_path, census_inds, lna_event_inds, flow_matrix_lna, do_prevalence, init_state, store_path);
+    return R_NilValue;
+END_RCPP
+}
 // map_pars_2_ode
 void map_pars_2_ode(arma::mat& pathmat, const arma::rowvec& ode_times, const Rcpp::NumericMatrix& ode_pars, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const int init_start, const Rcpp::LogicalVector& param_update_inds, const arma::mat& stoich_matrix, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, double step_size, SEXP ode_pointer, SEXP set_pars_pointer);
 RcppExport SEXP _stemr_map_pars_2_ode(SEXP pathmatSEXP, SEXP ode_timesSEXP, SEXP ode_parsSEXP, SEXP ode_param_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP init_startSEXP, SEXP param_update_indsSEXP, SEXP stoich_matrixSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP step_sizeSEXP, SEXP ode_pointerSEXP, SEXP set_pars_pointerSEXP) {
@@ -543,6 +1104,65 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// mcmc_driver_ode
+Rcpp::List mcmc_driver_ode(int iterations, int thin_params, int thin_latent_proc, int progress_interval, const std::string& status_file, arma::mat& kernel_cov_chol, SEXP adaptive_kernel, Rcpp::NumericMatrix& parameter_samples_nat, Rcpp::NumericMatrix& parameter_samples_est, Rcpp::NumericVector& data_log_lik_record, Rcpp::NumericVector& params_log_prior_record, Rcpp::NumericVector& ode_paths, int param_rec_ind, int path_rec_ind, Rcpp::NumericVector& model_params_est, Rcpp::NumericVector& model_params_nat, Rcpp::NumericVector& params_prop_est, Rcpp::NumericVector& params_prop_nat, const Rcpp::List& path, Rcpp::NumericMatrix& pathmat_prop, const Rcpp::NumericMatrix& data, const Rcpp::List& priors, Rcpp::NumericVector& params_logprior_cur, Rcpp::NumericMatrix& ode_params_cur, Rcpp::NumericVector& ode_param_vec, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& ode_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_const_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const Rcpp::IntegerVector& ode_initdist_inds, const arma::uvec& path_par_inds, SEXP ode_cache, const Rcpp::LogicalVector& param_update_inds, const arma::uvec& ode_event_inds, const Rcpp::IntegerVector& census_indices, const Rcpp::List& obs_layout, SEXP ode_pointer, SEXP ode_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size);
+RcppExport SEXP _stemr_mcmc_driver_ode(SEXP iterationsSEXP, SEXP thin_paramsSEXP, SEXP thin_latent_procSEXP, SEXP progress_intervalSEXP, SEXP status_fileSEXP, SEXP kernel_cov_cholSEXP, SEXP adaptive_kernelSEXP, SEXP parameter_samples_natSEXP, SEXP parameter_samples_estSEXP, SEXP data_log_lik_recordSEXP, SEXP params_log_prior_recordSEXP, SEXP ode_pathsSEXP, SEXP param_rec_indSEXP, SEXP path_rec_indSEXP, SEXP model_params_estSEXP, SEXP model_params_natSEXP, SEXP params_prop_estSEXP, SEXP params_prop_natSEXP, SEXP pathSEXP, SEXP pathmat_propSEXP, SEXP dataSEXP, SEXP priorsSEXP, SEXP params_logprior_curSEXP, SEXP ode_params_curSEXP, SEXP ode_param_vecSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP ode_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP ode_param_indsSEXP, SEXP ode_const_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP ode_initdist_indsSEXP, SEXP path_par_indsSEXP, SEXP ode_cacheSEXP, SEXP param_update_indsSEXP, SEXP ode_event_indsSEXP, SEXP census_indicesSEXP, SEXP obs_layoutSEXP, SEXP ode_pointerSEXP, SEXP ode_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type iterations(iterationsSEXP);
+    Rcpp::traits::input_parameter< int >::type thin_params(thin_paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type thin_latent_proc(thin_latent_procSEXP);
+    Rcpp::traits::input_parameter< int >::type progress_interval(progress_intervalSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type status_file(status_fileSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type kernel_cov_chol(kernel_cov_cholSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type adaptive_kernel(adaptive_kernelSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type parameter_samples_nat(parameter_samples_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type parameter_samples_est(parameter_samples_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type data_log_lik_record(data_log_lik_recordSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_log_prior_record(params_log_prior_recordSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_paths(ode_pathsSEXP);
+    Rcpp::traits::input_parameter< int >::type param_rec_ind(param_rec_indSEXP);
+    Rcpp::traits::input_parameter< int >::type path_rec_ind(path_rec_indSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_est(model_params_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type model_params_nat(model_params_natSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_est(params_prop_estSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_prop_nat(params_prop_natSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type params_logprior_cur(params_logprior_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type ode_params_cur(ode_params_curSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_param_vec(ode_param_vecSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_const_inds(ode_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_initdist_inds(ode_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type path_par_inds(path_par_indsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type ode_event_inds(ode_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_set_pars_pointer(ode_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(mcmc_driver_ode(iterations, thin_params, thin_latent_proc, progress_interval, status_file, kernel_cov_chol, adaptive_kernel, parameter_samples_nat, parameter_samples_est, data_log_lik_record, params_log_prior_record, ode_paths, param_rec_ind, path_rec_ind, model_params_est, model_params_nat, params_prop_est, params_prop_nat, path, pathmat_prop, data, priors, params_logprior_cur, ode_params_cur, ode_param_vec, censusmat, emitmat, flow_matrix, stoich_matrix, ode_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds, path_par_inds, ode_cache, param_update_inds, ode_event_inds, census_indices, obs_layout, ode_pointer, ode_set_pars_pointer, d_meas_pointer, do_prevalence, step_size));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rmvtn
 arma::mat rmvtn(int n, const arma::rowvec& mu, const arma::mat& sigma);
 RcppExport SEXP _stemr_rmvtn(SEXP nSEXP, SEXP muSEXP, SEXP sigmaSEXP) {
@@ -618,6 +1238,105 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// create_ode_cache
+SEXP create_ode_cache(int capacity);
+RcppExport SEXP _stemr_create_ode_cache(SEXP capacitySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type capacity(capacitySEXP);
+    rcpp_result_gen = Rcpp::wrap(create_ode_cache(capacity));
+    return rcpp_result_gen;
+END_RCPP
+}
+// map_pars_2_ode_cached
+bool map_pars_2_ode_cached(SEXP ode_cache, const arma::uvec& key_inds, arma::mat& pathmat, const arma::rowvec& ode_times, const Rcpp::NumericMatrix& ode_pars, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const int init_start, const Rcpp::LogicalVector& param_update_inds, const arma::mat& stoich_matrix, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, double step_size, SEXP ode_pointer, SEXP set_pars_pointer);
+RcppExport SEXP _stemr_map_pars_2_ode_cached(SEXP ode_cacheSEXP, SEXP key_indsSEXP, SEXP pathmatSEXP, SEXP ode_timesSEXP, SEXP ode_parsSEXP, SEXP ode_param_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP init_startSEXP, SEXP param_update_indsSEXP, SEXP stoich_matrixSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP step_sizeSEXP, SEXP ode_pointerSEXP, SEXP set_pars_pointerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type key_inds(key_indsSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type pathmat(pathmatSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type ode_pars(ode_parsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const int >::type init_start(init_startSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type set_pars_pointer(set_pars_pointerSEXP);
+    rcpp_result_gen = Rcpp::wrap(map_pars_2_ode_cached(ode_cache, key_inds, pathmat, ode_times, ode_pars, ode_param_inds, ode_tcovar_inds, init_start, param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, step_size, ode_pointer, set_pars_pointer));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ode_cache_set_origin
+void ode_cache_set_origin(SEXP ode_cache, double origin);
+RcppExport SEXP _stemr_ode_cache_set_origin(SEXP ode_cacheSEXP, SEXP originSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< double >::type origin(originSEXP);
+    ode_cache_set_origin(ode_cache, origin);
+    return R_NilValue;
+END_RCPP
+}
+// ode_cache_loglik
+double ode_cache_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds);
+RcppExport SEXP _stemr_ode_cache_loglik(SEXP ode_cacheSEXP, SEXP ode_parsSEXP, SEXP key_indsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type ode_pars(ode_parsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type key_inds(key_indsSEXP);
+    rcpp_result_gen = Rcpp::wrap(ode_cache_loglik(ode_cache, ode_pars, key_inds));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ode_cache_set_loglik
+void ode_cache_set_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds, double loglik);
+RcppExport SEXP _stemr_ode_cache_set_loglik(SEXP ode_cacheSEXP, SEXP ode_parsSEXP, SEXP key_indsSEXP, SEXP loglikSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type ode_pars(ode_parsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type key_inds(key_indsSEXP);
+    Rcpp::traits::input_parameter< double >::type loglik(loglikSEXP);
+    ode_cache_set_loglik(ode_cache, ode_pars, key_inds, loglik);
+    return R_NilValue;
+END_RCPP
+}
+// ode_cache_stats
+Rcpp::List ode_cache_stats(SEXP ode_cache);
+RcppExport SEXP _stemr_ode_cache_stats(SEXP ode_cacheSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ode_cache(ode_cacheSEXP);
+    rcpp_result_gen = Rcpp::wrap(ode_cache_stats(ode_cache));
+    return rcpp_result_gen;
+END_RCPP
+}
+// path_pars_changed
+bool path_pars_changed(const arma::mat& pars, const arma::mat& pars_ref, const arma::uvec& col_inds);
+RcppExport SEXP _stemr_path_pars_changed(SEXP parsSEXP, SEXP pars_refSEXP, SEXP col_indsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type pars(parsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type pars_ref(pars_refSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type col_inds(col_indsSEXP);
+    rcpp_result_gen = Rcpp::wrap(path_pars_changed(pars, pars_ref, col_inds));
+    return rcpp_result_gen;
+END_RCPP
+}
 // propose_lna
 Rcpp::List propose_lna(const arma::rowvec& lna_times, const Rcpp::NumericVector& lna_draws, const Rcpp::NumericMatrix& lna_pars, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const int init_start, const Rcpp::LogicalVector& param_update_inds, const arma::mat& stoich_matrix, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, int max_attempts, double step_size, SEXP lna_pointer, SEXP set_pars_pointer);
 RcppExport SEXP _stemr_propose_lna(SEXP lna_timesSEXP, SEXP lna_drawsSEXP, SEXP lna_parsSEXP, SEXP lna_param_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP init_startSEXP, SEXP param_update_indsSEXP, SEXP stoich_matrixSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP max_attemptsSEXP, SEXP step_sizeSEXP, SEXP lna_pointerSEXP, SEXP set_pars_pointerSEXP) {
@@ -750,18 +1469,152 @@ BEGIN_RCPP
 END_RCPP
 }
 // simulate_r_measure
-Rcpp::NumericMatrix simulate_r_measure(Rcpp::NumericMatrix& censusmat, Rcpp::LogicalMatrix& measproc_indmat, Rcpp::NumericVector& parameters, Rcpp::NumericVector& constants, Rcpp::NumericMatrix& tcovar, SEXP r_measure_ptr);
-RcppExport SEXP _stemr_simulate_r_measure(SEXP censusmatSEXP, SEXP measproc_indmatSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovarSEXP, SEXP r_measure_ptrSEXP) {
+Rcpp::NumericMatrix simulate_r_measure(Rcpp::NumericMatrix& censusmat, const Rcpp::List& obs_layout, Rcpp::NumericVector& parameters, Rcpp::NumericVector& constants, Rcpp::NumericMatrix& tcovar, SEXP r_measure_ptr);
+RcppExport SEXP _stemr_simulate_r_measure(SEXP censusmatSEXP, SEXP obs_layoutSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovarSEXP, SEXP r_measure_ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
-    Rcpp::traits::input_parameter< Rcpp::LogicalMatrix& >::type measproc_indmat(measproc_indmatSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type parameters(parametersSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type constants(constantsSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type tcovar(tcovarSEXP);
     Rcpp::traits::input_parameter< SEXP >::type r_measure_ptr(r_measure_ptrSEXP);
-    rcpp_result_gen = Rcpp::wrap(simulate_r_measure(censusmat, measproc_indmat, parameters, constants, tcovar, r_measure_ptr));
+    rcpp_result_gen = Rcpp::wrap(simulate_r_measure(censusmat, obs_layout, parameters, constants, tcovar, r_measure_ptr));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simulate_r_measure_batch
+arma::cube simulate_r_measure_batch(const arma::cube& censusmats, const Rcpp::List& obs_layout, const arma::mat& parameters, const arma::vec& constants, const arma::cube& tcovars, SEXP r_meas_native_ptr, int seed, int n_threads);
+RcppExport SEXP _stemr_simulate_r_measure_batch(SEXP censusmatsSEXP, SEXP obs_layoutSEXP, SEXP parametersSEXP, SEXP constantsSEXP, SEXP tcovarsSEXP, SEXP r_meas_native_ptrSEXP, SEXP seedSEXP, SEXP n_threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::cube& >::type censusmats(censusmatsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type parameters(parametersSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type constants(constantsSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type tcovars(tcovarsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type r_meas_native_ptr(r_meas_native_ptrSEXP);
+    Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type n_threads(n_threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(simulate_r_measure_batch(censusmats, obs_layout, parameters, constants, tcovars, r_meas_native_ptr, seed, n_threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// tpar_draws2par
+arma::vec tpar_draws2par(const arma::vec& draws, const arma::vec& hyper, std::string type, std::string link, const arma::mat& basis, int n_values);
+RcppExport SEXP _stemr_tpar_draws2par(SEXP drawsSEXP, SEXP hyperSEXP, SEXP typeSEXP, SEXP linkSEXP, SEXP basisSEXP, SEXP n_valuesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::vec& >::type draws(drawsSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type hyper(hyperSEXP);
+    Rcpp::traits::input_parameter< std::string >::type type(typeSEXP);
+    Rcpp::traits::input_parameter< std::string >::type link(linkSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type basis(basisSEXP);
+    Rcpp::traits::input_parameter< int >::type n_values(n_valuesSEXP);
+    rcpp_result_gen = Rcpp::wrap(tpar_draws2par(draws, hyper, type, link, basis, n_values));
+    return rcpp_result_gen;
+END_RCPP
+}
+// tparam_ess_update_lna
+void tparam_ess_update_lna(const Rcpp::List& tparam, const Rcpp::List& path_cur, const Rcpp::NumericMatrix& data, Rcpp::NumericMatrix& lna_parameters, Rcpp::NumericVector& lna_param_vec, Rcpp::NumericMatrix& pathmat_prop, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& lna_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& lna_param_inds, const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds, const Rcpp::IntegerVector& lna_initdist_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, const arma::uvec& lna_event_inds, const Rcpp::List& obs_layout, arma::vec& svd_d, arma::mat& svd_U, arma::mat& svd_V, SEXP lna_pointer, SEXP lna_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, Rcpp::NumericVector& tparam_steps, Rcpp::NumericVector& tparam_angle, double tparam_bracket_width, int n_tparam_updates, const Rcpp::List& lik_cache);
+RcppExport SEXP _stemr_tparam_ess_update_lna(SEXP tparamSEXP, SEXP path_curSEXP, SEXP dataSEXP, SEXP lna_parametersSEXP, SEXP lna_param_vecSEXP, SEXP pathmat_propSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP lna_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP lna_param_indsSEXP, SEXP lna_const_indsSEXP, SEXP lna_tcovar_indsSEXP, SEXP lna_initdist_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP lna_event_indsSEXP, SEXP obs_layoutSEXP, SEXP svd_dSEXP, SEXP svd_USEXP, SEXP svd_VSEXP, SEXP lna_pointerSEXP, SEXP lna_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP tparam_stepsSEXP, SEXP tparam_angleSEXP, SEXP tparam_bracket_widthSEXP, SEXP n_tparam_updatesSEXP, SEXP lik_cacheSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path_cur(path_curSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type lna_parameters(lna_parametersSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type lna_param_vec(lna_param_vecSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type lna_times(lna_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_param_inds(lna_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_const_inds(lna_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_tcovar_inds(lna_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type lna_initdist_inds(lna_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type lna_event_inds(lna_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< arma::vec& >::type svd_d(svd_dSEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_U(svd_USEXP);
+    Rcpp::traits::input_parameter< arma::mat& >::type svd_V(svd_VSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_pointer(lna_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type lna_set_pars_pointer(lna_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type tparam_steps(tparam_stepsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type tparam_angle(tparam_angleSEXP);
+    Rcpp::traits::input_parameter< double >::type tparam_bracket_width(tparam_bracket_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type n_tparam_updates(n_tparam_updatesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type lik_cache(lik_cacheSEXP);
+    tparam_ess_update_lna(tparam, path_cur, data, lna_parameters, lna_param_vec, pathmat_prop, censusmat, emitmat, flow_matrix, stoich_matrix, lna_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, lna_param_inds, lna_const_inds, lna_tcovar_inds, lna_initdist_inds, param_update_inds, census_indices, lna_event_inds, obs_layout, svd_d, svd_U, svd_V, lna_pointer, lna_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, tparam_steps, tparam_angle, tparam_bracket_width, n_tparam_updates, lik_cache);
+    return R_NilValue;
+END_RCPP
+}
+// tparam_ess_update_ode
+void tparam_ess_update_ode(const Rcpp::List& tparam, const Rcpp::List& path_cur, const Rcpp::NumericMatrix& data, Rcpp::NumericMatrix& ode_parameters, Rcpp::NumericVector& ode_param_vec, Rcpp::NumericMatrix& pathmat_prop, Rcpp::NumericMatrix& censusmat, Rcpp::NumericMatrix& emitmat, const arma::mat& flow_matrix, const arma::mat& stoich_matrix, const arma::rowvec& ode_times, const Rcpp::LogicalVector& forcing_inds, const arma::uvec& forcing_tcov_inds, const arma::mat& forcings_out, const arma::cube& forcing_transfers, const Rcpp::IntegerVector& ode_param_inds, const Rcpp::IntegerVector& ode_const_inds, const Rcpp::IntegerVector& ode_tcovar_inds, const Rcpp::IntegerVector& ode_initdist_inds, const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices, const arma::uvec& ode_event_inds, const Rcpp::List& obs_layout, SEXP ode_pointer, SEXP ode_set_pars_pointer, SEXP d_meas_pointer, bool do_prevalence, double step_size, Rcpp::NumericVector& tparam_steps, Rcpp::NumericVector& tparam_angle, double tparam_bracket_width, int n_tparam_updates);
+RcppExport SEXP _stemr_tparam_ess_update_ode(SEXP tparamSEXP, SEXP path_curSEXP, SEXP dataSEXP, SEXP ode_parametersSEXP, SEXP ode_param_vecSEXP, SEXP pathmat_propSEXP, SEXP censusmatSEXP, SEXP emitmatSEXP, SEXP flow_matrixSEXP, SEXP stoich_matrixSEXP, SEXP ode_timesSEXP, SEXP forcing_indsSEXP, SEXP forcing_tcov_indsSEXP, SEXP forcings_outSEXP, SEXP forcing_transfersSEXP, SEXP ode_param_indsSEXP, SEXP ode_const_indsSEXP, SEXP ode_tcovar_indsSEXP, SEXP ode_initdist_indsSEXP, SEXP param_update_indsSEXP, SEXP census_indicesSEXP, SEXP ode_event_indsSEXP, SEXP obs_layoutSEXP, SEXP ode_pointerSEXP, SEXP ode_set_pars_pointerSEXP, SEXP d_meas_pointerSEXP, SEXP do_prevalenceSEXP, SEXP step_sizeSEXP, SEXP tparam_stepsSEXP, SEXP tparam_angleSEXP, SEXP tparam_bracket_widthSEXP, SEXP n_tparam_updatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type tparam(tparamSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type path_cur(path_curSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type ode_parameters(ode_parametersSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type ode_param_vec(ode_param_vecSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type pathmat_prop(pathmat_propSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type censusmat(censusmatSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericMatrix& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type flow_matrix(flow_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type stoich_matrix(stoich_matrixSEXP);
+    Rcpp::traits::input_parameter< const arma::rowvec& >::type ode_times(ode_timesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type forcing_inds(forcing_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type forcing_tcov_inds(forcing_tcov_indsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type forcings_out(forcings_outSEXP);
+    Rcpp::traits::input_parameter< const arma::cube& >::type forcing_transfers(forcing_transfersSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_param_inds(ode_param_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_const_inds(ode_const_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_tcovar_inds(ode_tcovar_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type ode_initdist_inds(ode_initdist_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::LogicalVector& >::type param_update_inds(param_update_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type census_indices(census_indicesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type ode_event_inds(ode_event_indsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_pointer(ode_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ode_set_pars_pointer(ode_set_pars_pointerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type d_meas_pointer(d_meas_pointerSEXP);
+    Rcpp::traits::input_parameter< bool >::type do_prevalence(do_prevalenceSEXP);
+    Rcpp::traits::input_parameter< double >::type step_size(step_sizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type tparam_steps(tparam_stepsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector& >::type tparam_angle(tparam_angleSEXP);
+    Rcpp::traits::input_parameter< double >::type tparam_bracket_width(tparam_bracket_widthSEXP);
+    Rcpp::traits::input_parameter< int >::type n_tparam_updates(n_tparam_updatesSEXP);
+    tparam_ess_update_ode(tparam, path_cur, data, ode_parameters, ode_param_vec, pathmat_prop, censusmat, emitmat, flow_matrix, stoich_matrix, ode_times, forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers, ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds, param_update_inds, census_indices, ode_event_inds, obs_layout, ode_pointer, ode_set_pars_pointer, d_meas_pointer, do_prevalence, step_size, tparam_steps, tparam_angle, tparam_bracket_width, n_tparam_updates);
+    return R_NilValue;
+END_RCPP
+}
+// update_data_log_lik
+double update_data_log_lik(arma::vec& loglik_rows, const arma::mat& emitmat, const Rcpp::List& obs_layout, int row_start);
+RcppExport SEXP _stemr_update_data_log_lik(SEXP loglik_rowsSEXP, SEXP emitmatSEXP, SEXP obs_layoutSEXP, SEXP row_startSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< arma::vec& >::type loglik_rows(loglik_rowsSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type emitmat(emitmatSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type obs_layout(obs_layoutSEXP);
+    Rcpp::traits::input_parameter< int >::type row_start(row_startSEXP);
+    rcpp_result_gen = Rcpp::wrap(update_data_log_lik(loglik_rows, emitmat, obs_layout, row_start));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -798,19 +1651,30 @@ END_RCPP
 static const R_CallMethodDef CallEntries[] = {
     {"_stemr_CALL_D_MEASURE", (DL_FUNC) &_stemr_CALL_D_MEASURE, 9},
     {"_stemr_CALL_INTEGRATE_STEM_ODE", (DL_FUNC) &_stemr_CALL_INTEGRATE_STEM_ODE, 5},
+    {"_stemr_CALL_PARAM_TRANSFORM", (DL_FUNC) &_stemr_CALL_PARAM_TRANSFORM, 3},
+    {"_stemr_CALL_PRIOR_DENSITY", (DL_FUNC) &_stemr_CALL_PRIOR_DENSITY, 3},
     {"_stemr_CALL_RATE_FCN", (DL_FUNC) &_stemr_CALL_RATE_FCN, 7},
     {"_stemr_CALL_R_MEASURE", (DL_FUNC) &_stemr_CALL_R_MEASURE, 8},
     {"_stemr_CALL_SET_ODE_PARAMS", (DL_FUNC) &_stemr_CALL_SET_ODE_PARAMS, 2},
+    {"_stemr_rw_structure_band", (DL_FUNC) &_stemr_rw_structure_band, 2},
+    {"_stemr_band_chol", (DL_FUNC) &_stemr_band_chol, 1},
+    {"_stemr_band_sigma_ref", (DL_FUNC) &_stemr_band_sigma_ref, 2},
+    {"_stemr_rgmrf_rw", (DL_FUNC) &_stemr_rgmrf_rw, 3},
+    {"_stemr_dgmrf_band", (DL_FUNC) &_stemr_dgmrf_band, 4},
     {"_stemr_build_census_path", (DL_FUNC) &_stemr_build_census_path, 3},
+    {"_stemr_census_index_map", (DL_FUNC) &_stemr_census_index_map, 3},
+    {"_stemr_census_path_cached", (DL_FUNC) &_stemr_census_path_cached, 4},
+    {"_stemr_census_path_incidence", (DL_FUNC) &_stemr_census_path_incidence, 4},
     {"_stemr_census_incidence", (DL_FUNC) &_stemr_census_incidence, 3},
-    {"_stemr_census_lna", (DL_FUNC) &_stemr_census_lna, 12},
+    {"_stemr_census_lna", (DL_FUNC) &_stemr_census_lna, 13},
+    {"_stemr_compute_data_log_lik", (DL_FUNC) &_stemr_compute_data_log_lik, 2},
     {"_stemr_compute_incidence", (DL_FUNC) &_stemr_compute_incidence, 3},
     {"_stemr_convert_lna2", (DL_FUNC) &_stemr_convert_lna2, 4},
     {"_stemr_pars2lnapars", (DL_FUNC) &_stemr_pars2lnapars, 2},
     {"_stemr_pars2lnapars2", (DL_FUNC) &_stemr_pars2lnapars2, 3},
     {"_stemr_copy_elem", (DL_FUNC) &_stemr_copy_elem, 3},
     {"_stemr_copy_elem2", (DL_FUNC) &_stemr_copy_elem2, 3},
-    {"_stemr_increment_elem", (DL_FUNC) &_stemr_increment_elem, 2},
+    {"_stemr_increment_elem", (DL_FUNC) &_stemr_increment_elem, 3},
     {"_stemr_copy_vec", (DL_FUNC) &_stemr_copy_vec, 2},
     {"_stemr_copy_vec2", (DL_FUNC) &_stemr_copy_vec2, 3},
     {"_stemr_copy_mat", (DL_FUNC) &_stemr_copy_mat, 2},
@@ -825,21 +1689,41 @@ static const R_CallMethodDef CallEntries[] = {
     {"_stemr_draw_normals2", (DL_FUNC) &_stemr_draw_normals2, 1},
     {"_stemr_sample_unit_sphere", (DL_FUNC) &_stemr_sample_unit_sphere, 1},
     {"_stemr_evaluate_d_measure", (DL_FUNC) &_stemr_evaluate_d_measure, 8},
-    {"_stemr_evaluate_d_measure_LNA", (DL_FUNC) &_stemr_evaluate_d_measure_LNA, 12},
+    {"_stemr_evaluate_d_measure_LNA", (DL_FUNC) &_stemr_evaluate_d_measure_LNA, 13},
+    {"_stemr_factor_slice_update_lna", (DL_FUNC) &_stemr_factor_slice_update_lna, 47},
+    {"_stemr_factor_slice_update_ode", (DL_FUNC) &_stemr_factor_slice_update_ode, 45},
+    {"_stemr_find_dirty_range", (DL_FUNC) &_stemr_find_dirty_range, 6},
     {"_stemr_find_interval", (DL_FUNC) &_stemr_find_interval, 4},
     {"_stemr_g_prop2c_prop", (DL_FUNC) &_stemr_g_prop2c_prop, 3},
+    {"_stemr_hit_and_run_slice_update_lna", (DL_FUNC) &_stemr_hit_and_run_slice_update_lna, 49},
+    {"_stemr_hit_and_run_slice_update_ode", (DL_FUNC) &_stemr_hit_and_run_slice_update_ode, 47},
+    {"_stemr_initdist_ess_update_lna", (DL_FUNC) &_stemr_initdist_ess_update_lna, 38},
+    {"_stemr_initdist_ess_update_ode", (DL_FUNC) &_stemr_initdist_ess_update_ode, 35},
     {"_stemr_insert_tparam", (DL_FUNC) &_stemr_insert_tparam, 4},
     {"_stemr_integrate_odes", (DL_FUNC) &_stemr_integrate_odes, 14},
+    {"_stemr_chol_update", (DL_FUNC) &_stemr_chol_update, 2},
+    {"_stemr_update_kernel_cov", (DL_FUNC) &_stemr_update_kernel_cov, 6},
+    {"_stemr_track_factors", (DL_FUNC) &_stemr_track_factors, 4},
+    {"_stemr_update_factors_subspace", (DL_FUNC) &_stemr_update_factors_subspace, 3},
     {"_stemr_lna_incid2prev", (DL_FUNC) &_stemr_lna_incid2prev, 8},
     {"_stemr_map_draws_2_lna", (DL_FUNC) &_stemr_map_draws_2_lna, 20},
+    {"_stemr_map_draws_2_lna_census", (DL_FUNC) &_stemr_map_draws_2_lna_census, 27},
     {"_stemr_map_pars_2_ode", (DL_FUNC) &_stemr_map_pars_2_ode, 15},
     {"_stemr_comp_chol", (DL_FUNC) &_stemr_comp_chol, 2},
+    {"_stemr_mcmc_driver_ode", (DL_FUNC) &_stemr_mcmc_driver_ode, 49},
     {"_stemr_rmvtn", (DL_FUNC) &_stemr_rmvtn, 3},
     {"_stemr_dmvtn", (DL_FUNC) &_stemr_dmvtn, 4},
     {"_stemr_mvn_g_adaptive", (DL_FUNC) &_stemr_mvn_g_adaptive, 4},
     {"_stemr_mvn_rw", (DL_FUNC) &_stemr_mvn_rw, 3},
     {"_stemr_normalise", (DL_FUNC) &_stemr_normalise, 2},
     {"_stemr_normalise2", (DL_FUNC) &_stemr_normalise2, 2},
+    {"_stemr_create_ode_cache", (DL_FUNC) &_stemr_create_ode_cache, 1},
+    {"_stemr_map_pars_2_ode_cached", (DL_FUNC) &_stemr_map_pars_2_ode_cached, 17},
+    {"_stemr_ode_cache_set_origin", (DL_FUNC) &_stemr_ode_cache_set_origin, 2},
+    {"_stemr_ode_cache_loglik", (DL_FUNC) &_stemr_ode_cache_loglik, 3},
+    {"_stemr_ode_cache_set_loglik", (DL_FUNC) &_stemr_ode_cache_set_loglik, 4},
+    {"_stemr_ode_cache_stats", (DL_FUNC) &_stemr_ode_cache_stats, 1},
+    {"_stemr_path_pars_changed", (DL_FUNC) &_stemr_path_pars_changed, 3},
     {"_stemr_propose_lna", (DL_FUNC) &_stemr_propose_lna, 16},
     {"_stemr_propose_lna_approx", (DL_FUNC) &_stemr_propose_lna_approx, 19},
     {"_stemr_rate_update_event", (DL_FUNC) &_stemr_rate_update_event, 3},
@@ -848,6 +1732,11 @@ static const R_CallMethodDef CallEntries[] = {
     {"_stemr_retrieve_census_path", (DL_FUNC) &_stemr_retrieve_census_path, 4},
     {"_stemr_simulate_gillespie", (DL_FUNC) &_stemr_simulate_gillespie, 15},
     {"_stemr_simulate_r_measure", (DL_FUNC) &_stemr_simulate_r_measure, 6},
+    {"_stemr_simulate_r_measure_batch", (DL_FUNC) &_stemr_simulate_r_measure_batch, 8},
+    {"_stemr_tpar_draws2par", (DL_FUNC) &_stemr_tpar_draws2par, 6},
+    {"_stemr_tparam_ess_update_lna", (DL_FUNC) &_stemr_tparam_ess_update_lna, 36},
+    {"_stemr_tparam_ess_update_ode", (DL_FUNC) &_stemr_tparam_ess_update_ode, 32},
+    {"_stemr_update_data_log_lik", (DL_FUNC) &_stemr_update_data_log_lik, 4},
     {"_stemr_update_factors", (DL_FUNC) &_stemr_update_factors, 3},
     {"_stemr_update_interval_widths", (DL_FUNC) &_stemr_update_interval_widths, 8},
     {NULL, NULL, 0}
@@ -0,0 +1,255 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "banded_gmrf.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Structure matrix of a random walk, in banded storage.
+//'
+//' The structure matrix, \eqn{R = D^T D}, where D is the matrix of differences
+//' of order k, is built directly in banded storage, with \code{band[d+1, j]}
+//' equal to \code{R[j+d, j]}.
+//'
+//' @param ntimes number of times (nodes)
+//' @param order order of the random walk, 1, 2, or 3
+//'
+//' @return matrix with order+1 rows and ntimes columns containing the lower
+//'   bands of the structure matrix
+//' @export
+// [[Rcpp::export]]
+arma::mat rw_structure_band(int ntimes, int order) {
+
+      if(ntimes <= order) Rcpp::stop("The number of times must exceed the order of the random walk.");
+
+      // coefficients of the differences of order k
+      arma::vec coefs(order + 1);
+      for(int m = 0; m <= order; ++m) {
+            coefs[m] = R::choose(order, m) * (((order - m) % 2 == 0) ? 1.0 : -1.0);
+      }
+
+      // accumulate the outer products of the rows of the difference matrix
+      arma::mat band(order + 1, ntimes, arma::fill::zeros);
+
+      for(int i = 0; i < ntimes - order; ++i) {
+            for(int m1 = 0; m1 <= order; ++m1) {
+                  for(int m2 = m1; m2 <= order; ++m2) {
+                        band(m2 - m1, i + m1) += coefs[m1] * coefs[m2];
+                  }
+            }
+      }
+
+      return band;
+}
+
+arma::mat rw_kernel(int ntimes, int order) {
+
+      arma::mat kern(ntimes, order);
+      arma::vec t = arma::regspace(1, ntimes);
+
+      for(int k = 0; k < order; ++k) kern.col(k) = arma::pow(t, k);
+
+      return kern;
+}
+
+//' Cholesky decomposition of a banded precision matrix.
+//'
+//' @param band lower bands of a symmetric positive definite matrix, as returned
+//'   by \code{\link{rw_structure_band}}
+//'
+//' @return lower bands of the lower triangular cholesky factor, computed in
+//'   O(n bandwidth^2) operations
+//' @export
+// [[Rcpp::export]]
+arma::mat band_chol(const arma::mat& band) {
+
+      const int bw = band.n_rows - 1;
+      const int n  = band.n_cols;
+      arma::mat chol(bw + 1, n, arma::fill::zeros);
+
+      for(int j = 0; j < n; ++j) {
+
+            double diag = band(0, j);
+            for(int k = std::max(0, j - bw); k < j; ++k) diag -= chol(j - k, k) * chol(j - k, k);
+
+            if(diag <= 0) Rcpp::stop("The banded precision matrix is not positive definite.");
+            chol(0, j) = std::sqrt(diag);
+
+            for(int i = j + 1; i <= std::min(j + bw, n - 1); ++i) {
+
+                  double val = band(i - j, j);
+                  for(int k = std::max(0, i - bw); k < j; ++k) val -= chol(i - k, k) * chol(j - k, k);
+
+                  chol(i - j, j) = val / chol(0, j);
+            }
+      }
+
+      return chol;
+}
+
+void band_forward_solve(const arma::mat& chol, arma::vec& x) {
+
+      const int bw = chol.n_rows - 1;
+      const int n  = chol.n_cols;
+
+      for(int i = 0; i < n; ++i) {
+            for(int j = std::max(0, i - bw); j < i; ++j) x[i] -= chol(i - j, j) * x[j];
+            x[i] /= chol(0, i);
+      }
+}
+
+void band_backward_solve(const arma::mat& chol, arma::vec& x) {
+
+      const int bw = chol.n_rows - 1;
+      const int n  = chol.n_cols;
+
+      for(int i = n - 1; i >= 0; --i) {
+            for(int j = i + 1; j <= std::min(i + bw, n - 1); ++j) x[i] -= chol(j - i, i) * x[j];
+            x[i] /= chol(0, i);
+      }
+}
+
+double band_quad_form(const arma::mat& band, const arma::vec& x) {
+
+      const int bw = band.n_rows - 1;
+      const int n  = band.n_cols;
+      double quad  = 0.0;
+
+      for(int j = 0; j < n; ++j) {
+            quad += band(0, j) * x[j] * x[j];
+            for(int d = 1; d <= std::min(bw, n - 1 - j); ++d) quad += 2.0 * band(d, j) * x[j + d] * x[j];
+      }
+
+      return quad;
+}
+
+arma::mat band_selected_inverse(const arma::mat& chol) {
+
+      const int bw = chol.n_rows - 1;
+      const int n  = chol.n_cols;
+      arma::mat sigma(bw + 1, n, arma::fill::zeros);
+
+      // backward recursion for the entries of the inverse within the band, Rue and Held (2005)
+      for(int i = n - 1; i >= 0; --i) {
+
+            const int last = std::min(i + bw, n - 1);
+
+            for(int j = last; j >= i; --j) {
+
+                  double val = (i == j) ? 1.0 / chol(0, i) : 0.0;
+
+                  for(int k = i + 1; k <= last; ++k) {
+                        val -= chol(k - i, i) * ((k >= j) ? sigma(k - j, j) : sigma(j - k, k));
+                  }
+
+                  sigma(j - i, i) = val / chol(0, i);
+            }
+      }
+
+      return sigma;
+}
+
+arma::mat orthonormal_kernel(const arma::mat& kern) {
+
+      arma::mat U, R;
+      arma::qr_econ(U, R, kern);
+
+      return U;
+}
+
+void band_sample_constrained(arma::vec& x, const arma::mat& chol, const arma::mat& kern) {
+
+      const int k = kern.n_cols;
+      const int n = chol.n_cols + k;
+
+      // proper draw with the first k nodes fixed at zero, L^T y = z
+      arma::vec y(n - k);
+      y.imbue(norm_rand);
+      band_backward_solve(chol, y);
+
+      x.zeros(n);
+      x.tail(n - k) = y;
+
+      // project onto the orthogonal complement of the null space
+      x -= kern * (kern.t() * x);
+}
+
+//' Generalized variance of an intrinsic GMRF.
+//'
+//' Computes the geometric mean of the marginal standard deviations of an
+//' intrinsic GMRF with a banded structure matrix, subject to the constraint
+//' that it is orthogonal to the null space of the structure matrix. The GMRF
+//' with its first k nodes fixed at zero is proper, and its projection onto the
+//' orthogonal complement of the null space has the constrained distribution,
+//' so the marginal variances are computed from a banded cholesky factor and
+//' the band of its inverse at a cost that is linear in the number of nodes.
+//'
+//' @param band lower bands of the structure matrix
+//' @param kern matrix with k columns spanning the null space of the structure
+//'   matrix, whose first k rows are linearly independent
+//'
+//' @return reference standard deviation of the GMRF
+//' @export
+// [[Rcpp::export]]
+double band_sigma_ref(const arma::mat& band, const arma::mat& kern) {
+
+      const int k = kern.n_cols;
+      const int n = band.n_cols;
+
+      arma::mat U     = orthonormal_kernel(kern);
+      arma::mat chol  = band_chol(band.cols(k, n - 1));
+      arma::mat sigma = band_selected_inverse(chol);
+
+      // S0 U, where S0 is the covariance of the GMRF with the first k nodes fixed at zero
+      arma::mat S0U(n, k, arma::fill::zeros);
+      for(int c = 0; c < k; ++c) {
+            arma::vec v = U.col(c).tail(n - k);
+            band_forward_solve(chol, v);
+            band_backward_solve(chol, v);
+            S0U.col(c).tail(n - k) = v;
+      }
+
+      // diag((I - U U^T) S0 (I - U U^T))
+      arma::vec vars(n, arma::fill::zeros);
+      vars.tail(n - k) = sigma.row(0).t();
+      vars += arma::sum((U * (U.t() * S0U)) % U, 1) - 2.0 * arma::sum(S0U % U, 1);
+
+      return std::exp(0.5 * arma::mean(arma::log(vars)));
+}
+
+//' Sample a random walk with a banded precision matrix, subject to its
+//' constraints.
+//'
+//' @param ntimes number of times (nodes)
+//' @param order order of the random walk, 1, 2, or 3
+//' @param precision precision of the random walk
+//'
+//' @return vector drawn from the GMRF with precision matrix precision * R,
+//'   orthogonal to the null space of R
+//' @export
+// [[Rcpp::export]]
+arma::vec rgmrf_rw(int ntimes, int order, double precision) {
+
+      arma::mat band = precision * rw_structure_band(ntimes, order);
+
+      arma::vec x;
+      band_sample_constrained(x,
+                              band_chol(band.cols(order, ntimes - 1)),
+                              orthonormal_kernel(rw_kernel(ntimes, order)));
+
+      return x;
+}
+
+//' Log density of an intrinsic GMRF with a banded structure matrix.
+//'
+//' @param x vector at which to evaluate the density
+//' @param band lower bands of the structure matrix
+//' @param precision precision of the GMRF
+//' @param rank rank of the structure matrix
+//'
+//' @return 0.5 r log(precision) - 0.5 precision x^T R x - 0.5 r log(2 pi),
+//'   computed in O(n bandwidth) operations
+//' @export
+// [[Rcpp::export]]
+double dgmrf_band(const arma::vec& x, const arma::mat& band, double precision, int rank) {
+      return 0.5 * rank * (std::log(precision) - M_LN_2PI) - 0.5 * precision * band_quad_form(band, x);
+}
@@ -0,0 +1,37 @@
+#ifndef stemr_banded_gmrf_h
+#define stemr_banded_gmrf_h
+
+#include <RcppArmadillo.h>
+
+// symmetric banded matrices are stored by their lower bands, band(d, j) = Q(j + d, j) for
+// d = 0, ..., bandwidth, with the entries past the end of each band set to zero. lower
+// triangular banded cholesky factors are stored in the same way.
+
+// structure matrix of a random walk of order k, bandwidth k
+arma::mat rw_structure_band(int ntimes, int order);
+
+// kernel of the structure matrix of a random walk of order k, columns 1, t, t^2, ...
+arma::mat rw_kernel(int ntimes, int order);
+
+// banded cholesky factor of a banded precision matrix
+arma::mat band_chol(const arma::mat& band);
+
+// solve L x = b and L^T x = b in place for a banded cholesky factor L
+void band_forward_solve(const arma::mat& chol, arma::vec& x);
+void band_backward_solve(const arma::mat& chol, arma::vec& x);
+
+// x^T Q x for a banded Q
+double band_quad_form(const arma::mat& band, const arma::vec& x);
+
+// band of the inverse of Q from its banded cholesky factor
+arma::mat band_selected_inverse(const arma::mat& chol);
+
+// orthonormal basis for the columns of a kernel matrix
+arma::mat orthonormal_kernel(const arma::mat& kern);
+
+// draw x from an intrinsic GMRF subject to kern^T x = 0. chol is the banded cholesky factor of
+// the precision matrix with its first k = kern.n_cols nodes removed, which is proper when those
+// nodes determine the null space, and kern has orthonormal columns.
+void band_sample_constrained(arma::vec& x, const arma::mat& chol, const arma::mat& kern);
+
+#endif
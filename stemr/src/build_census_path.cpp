@@ -1,6 +1,7 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include "stemr_types.h"
 #include "stemr_utils.h"
+#include "census_engine.h"
 
 using namespace arma;
 using namespace Rcpp;
@@ -17,26 +18,20 @@ using namespace Rcpp;
 // [[Rcpp::export]]
 arma::mat build_census_path(Rcpp::NumericMatrix& path, Rcpp::NumericVector& census_times, Rcpp::IntegerVector& census_columns) {
 
-        // get dimensions
-        int n_census_times = census_times.size();
-        int n_comps = census_columns.size();
-
-        Rcpp::IntegerVector path_dims = path.attr("dim");
-
         // get path matrix pointers
-        arma::mat path_mat(path.begin(), path_dims[0], path_dims[1], false);
+        arma::mat path_mat(path.begin(), path.nrow(), path.ncol(), false);
 
-        // initialize census matrix
-        arma::mat census_matrix(n_census_times, n_comps + 1);
-        census_matrix.col(0) = Rcpp::as<arma::colvec>(census_times);
+        // locate the census times in the path by a linear merge
+        arma::uvec census_inds;
+        merge_census_inds(census_inds, path_mat.colptr(0), path_mat.n_rows,
+                          census_times.begin(), census_times.size(), false);
 
-        // get vector of times in the path matrix and the census time indices
-        Rcpp::NumericVector timevec = path(_,0);
-        Rcpp::IntegerVector census_inds(n_census_times);
-        census_inds = find_interval(census_times, timevec, false, false) - 1; // rightmost_closed = true, all.inside = true
+        // initialize and fill out the census matrix
+        arma::mat census_matrix(census_times.size(), census_columns.size() + 1);
+        std::copy(census_times.begin(), census_times.end(), census_matrix.colptr(0));
 
-        // fill out the census matrix
-        census_matrix.cols(1, n_comps) = path_mat.submat(Rcpp::as<arma::uvec>(census_inds), Rcpp::as<arma::uvec>(census_columns));
+        fill_census(census_matrix, path_mat, census_inds, census_columns,
+                    std::vector<bool>(census_columns.size() + 1, false));
 
         return census_matrix;
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "census_engine.h"
+#include <algorithm>
+
+using namespace arma;
+using namespace Rcpp;
+
+void merge_census_inds(arma::uvec& census_inds,
+                       const double* path_times,
+                       int n_path,
+                       const double* census_times,
+                       int n_census,
+                       bool all_inside) {
+
+        census_inds.set_size(n_census);
+
+        bool sorted = std::is_sorted(census_times, census_times + n_census);
+        int pos     = 0; // number of path times at or before the current census time
+
+        for(int k = 0; k < n_census; ++k) {
+
+                if(sorted) {
+                        while(pos < n_path && path_times[pos] <= census_times[k]) ++pos;
+                } else {
+                        pos = std::upper_bound(path_times, path_times + n_path, census_times[k]) - path_times;
+                }
+
+                int ind = pos;
+                if(all_inside) {
+                        if(ind == n_path) {
+                                ind -= 1;
+                        } else if(ind == 0) {
+                                ind += 1;
+                        }
+                }
+
+                census_inds[k] = std::max(ind - 1, 0);
+        }
+}
+
+void fill_census(arma::mat& censusmat,
+                 const arma::mat& path,
+                 const arma::uvec& census_inds,
+                 const Rcpp::IntegerVector& census_columns,
+                 const std::vector<bool>& incidence) {
+
+        int n_census = census_inds.n_elem;
+
+        for(int c = 0; c < census_columns.size(); ++c) {
+
+                const double* path_col = path.colptr(census_columns[c]);
+                double* census_col     = censusmat.colptr(c + 1);
+
+                if(incidence[c + 1]) {
+                        double prev = 0.0;
+                        for(int k = 0; k < n_census; ++k) {
+                                double cur    = path_col[census_inds[k]];
+                                census_col[k] = (k == 0) ? cur : cur - prev;
+                                prev          = cur;
+                        }
+                } else {
+                        for(int k = 0; k < n_census; ++k) census_col[k] = path_col[census_inds[k]];
+                }
+        }
+}
+
+//' Compute the path row indices for a sequence of census times.
+//'
+//' The indices can be cached and supplied to \code{\link{census_path_cached}}
+//' when the path times are fixed, e.g., for the time-varying covariate matrix.
+//'
+//' @param path_times sorted vector of times in the path matrix
+//' @param census_times vector of census times
+//' @param all_inside logical; if true, the indices are restricted as in
+//'   \code{\link{find_interval}} with \code{all_inside = TRUE}
+//'
+//' @return vector of C++ row indices of the path at the census times
+//' @export
+// [[Rcpp::export]]
+arma::uvec census_index_map(const Rcpp::NumericVector& path_times, const Rcpp::NumericVector& census_times, bool all_inside = false) {
+
+        arma::uvec census_inds;
+        merge_census_inds(census_inds, path_times.begin(), path_times.size(),
+                          census_times.begin(), census_times.size(), all_inside);
+
+        return census_inds;
+}
+
+//' Construct a matrix containing the compartment counts at a sequence of census
+//' times, using cached path row indices.
+//'
+//' @param path matrix containing the path to be censused.
+//' @param census_times vector of census times.
+//' @param census_inds vector of C++ row indices of the path at the census times,
+//'   generated by \code{\link{census_index_map}}.
+//' @param census_columns vector of column indices to be censused (C++ indexing
+//'   beginning at 0).
+//'
+//' @return matrix containing the compartment counts at census times.
+//' @export
+// [[Rcpp::export]]
+arma::mat census_path_cached(const arma::mat& path,
+                             const Rcpp::NumericVector& census_times,
+                             const arma::uvec& census_inds,
+                             const Rcpp::IntegerVector& census_columns) {
+
+        arma::mat census_matrix(census_times.size(), census_columns.size() + 1);
+        std::copy(census_times.begin(), census_times.end(), census_matrix.colptr(0));
+
+        fill_census(census_matrix, path, census_inds, census_columns,
+                    std::vector<bool>(census_columns.size() + 1, false));
+
+        return census_matrix;
+}
+
+//' Construct a matrix containing the compartment counts and incidence at a
+//' sequence of census times.
+//'
+//' The path rows at the census times are located by a linear merge of the
+//' sorted census times with the sorted event times, and the incidence columns
+//' are differenced while the census matrix is filled out, so the result is
+//' equivalent to calling \code{\link{build_census_path}} and then
+//' \code{\link{compute_incidence}} with all census times as incidence rows.
+//'
+//' @param path matrix containing the path to be censused.
+//' @param census_times vector of census times.
+//' @param census_columns vector of column indices to be censused (C++ indexing
+//'   beginning at 0).
+//' @param incidence_codes column indices in the census matrix of the incidence
+//'   variables
+//'
+//' @return matrix containing the compartment counts and incidence at census
+//'   times.
+//' @export
+// [[Rcpp::export]]
+arma::mat census_path_incidence(const arma::mat& path,
+                                const Rcpp::NumericVector& census_times,
+                                const Rcpp::IntegerVector& census_columns,
+                                const Rcpp::IntegerVector& incidence_codes) {
+
+        arma::uvec census_inds;
+        merge_census_inds(census_inds, path.colptr(0), path.n_rows,
+                          census_times.begin(), census_times.size(), false);
+
+        std::vector<bool> incidence(census_columns.size() + 1, false);
+        for(int k = 0; k < incidence_codes.size(); ++k) incidence[incidence_codes[k]] = true;
+
+        arma::mat census_matrix(census_times.size(), census_columns.size() + 1);
+        std::copy(census_times.begin(), census_times.end(), census_matrix.colptr(0));
+
+        fill_census(census_matrix, path, census_inds, census_columns, incidence);
+
+        return census_matrix;
+}
@@ -0,0 +1,25 @@
+#ifndef stemr_census_engine_h
+#define stemr_census_engine_h
+
+#include <RcppArmadillo.h>
+
+// path row indices for a sequence of census times, i.e., the index of the last path time at or
+// before each census time. sorted census times are located by a single linear merge with the
+// path times, unsorted census times by binary search. if all_inside, the intervals are
+// restricted as in find_interval with all_inside = true.
+void merge_census_inds(arma::uvec& census_inds,
+                       const double* path_times,
+                       int n_path,
+                       const double* census_times,
+                       int n_census,
+                       bool all_inside);
+
+// write the censused columns of the path into columns 1, ..., n of the census matrix, differencing
+// the incidence columns (census matrix column indices) across census times in the same pass
+void fill_census(arma::mat& censusmat,
+                 const arma::mat& path,
+                 const arma::uvec& census_inds,
+                 const Rcpp::IntegerVector& census_columns,
+                 const std::vector<bool>& incidence);
+
+#endif
@@ -17,16 +17,19 @@ arma::mat census_incidence(const arma::mat& incid_mat, const arma::vec& census_t
 
         int n_times  = census_times.n_elem;
         int n_events = incid_mat.n_cols - 1;
-        arma::uvec col_inds = Rcpp::as<arma::uvec>(Rcpp::wrap(Rcpp::seq(1,n_events)));
         arma::mat censusmat(n_times, incid_mat.n_cols, arma::fill::zeros);
         censusmat.col(0) = census_times;
 
-        // get interval indices
-        for(int k=0; k<n_times; ++k) {
-                censusmat(k, arma::span(1, n_events)) =
-                        arma::sum(incid_mat(arma::find(interval_inds==k), col_inds), 0);
+        // accumulate the increments into their census intervals in a single pass over the rows
+        for(int c=1; c <= n_events; ++c) {
+
+                const double* incid_col = incid_mat.colptr(c);
+                double* census_col      = censusmat.colptr(c);
+
+                for(unsigned int j=0; j < interval_inds.n_elem; ++j) {
+                        if(interval_inds[j] < static_cast<unsigned int>(n_times)) census_col[interval_inds[j]] += incid_col[j];
+                }
         }
 
         return censusmat;
-}
-
+}
\ No newline at end of file
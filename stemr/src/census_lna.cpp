@@ -1,5 +1,6 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include <RcppArmadillo.h>
+#include "forcing_operator.h"
 
 using namespace arma;
 using namespace Rcpp;
@@ -18,6 +19,8 @@ using namespace Rcpp;
 //'   time-varying covariance matrix a forcing is applied.
 //' @param lna_pars matrix with parameters, constants, and time varying 
 //'   covariates and parameters.
+//' @param census_start C++ index of the first row of the census matrix to be
+//'   recomputed, rows above it are left as is (see \code{find_dirty_range}).
 //'
 //' @return matrix containing the compartment counts at census times.
 //' @export
@@ -33,7 +36,8 @@ void census_lna(const arma::mat& path,
                 const Rcpp::LogicalVector& forcing_inds,
                 const arma::uvec& forcing_tcov_inds,
                 const arma::mat& forcings_out,
-                const arma::cube& forcing_transfers) {
+                const arma::cube& forcing_transfers,
+                int census_start = 0) {
 
         // get dimensions
         int n_census_times  = census_inds.n_elem;
@@ -44,13 +48,13 @@ void census_lna(const arma::mat& path,
         
         // for use with forcings
         double forcing_flow = 0;
-        arma::vec forcing_distvec(n_comps, arma::fill::zeros);
+        forcing_operator forcing_op(forcings_out, forcing_transfers);
         
         // get indices in the census_path matrix to keep incidence
         int incid_start = flow_matrix_lna.n_cols + 1;
         
         // census the incidence increments
-        for(int k = 1; k < n_census_times; ++k) {
+        for(int k = census_start + 1; k < n_census_times; ++k) {
               
               for(int j = 0; j < n_census_events; ++j) {
                     census_path(k-1, incid_start + j) = arma::sum(path(arma::span(census_inds[k-1]+1, census_inds[k]),
@@ -66,7 +70,20 @@ void census_lna(const arma::mat& path,
               arma::rowvec state(init_state);
               arma::rowvec increment(n_rates, arma::fill::zeros);
               
-              for(int k=1; k < n_census_times-1; ++k) {
+              // pick up from the last row that does not need to be recomputed
+              if(census_start > 0 && census_start < n_census_times-1) {
+                    
+                    state = census_path(census_start-1, arma::span(1, n_comps));
+                    
+                    if(forcing_inds[census_start]) {
+                          for(int s=0; s < n_forcings; ++s) {
+                                forcing_flow     = lna_pars(census_start, forcing_tcov_inds[s]);
+                                forcing_op.apply(state.memptr(), s, forcing_flow);
+                          }
+                    }
+              }
+              
+              for(int k = census_start + 1; k < n_census_times-1; ++k) {
                     
                     // numbers of transitions
                     increment = arma::sum(path(arma::span(census_inds[k-1] + 1, census_inds[k]),
@@ -84,8 +101,7 @@ void census_lna(const arma::mat& path,
                           // distribute the forcings proportionally to the compartment counts in the applicable states
                           for(int s=0; s < n_forcings; ++s) {
                                 forcing_flow     = lna_pars(k, forcing_tcov_inds[s]);
-                                forcing_distvec  = forcing_flow * normalise(forcings_out.col(s) % state, 1);
-                                state           += forcing_transfers.slice(s) * forcing_distvec;
+                                forcing_op.apply(state.memptr(), s, forcing_flow);
                           }
                     }
               }
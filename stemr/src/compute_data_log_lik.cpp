@@ -0,0 +1,61 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include <RcppArmadillo.h>
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Compute the data log-likelihood by summing the emission probabilities of
+//' the observed measurement variables.
+//'
+//' If the observation layout has an inv_temperature element, the
+//' log-likelihood is tempered, i.e., multiplied by the inverse temperature.
+//'
+//' @param emitmat matrix of emission probabilities
+//' @param obs_layout list with the compressed observation layout, see
+//'   \code{build_obs_layout}
+//'
+//' @return data log-likelihood
+//' @export
+// [[Rcpp::export]]
+double compute_data_log_lik(const arma::mat& emitmat, const Rcpp::List& obs_layout) {
+
+      // observation times for each measurement variable
+      Rcpp::List var_inds = obs_layout["var_inds"];
+
+      double data_log_lik = 0;
+
+      // the emission matrix is stored by column, so sum one variable at a time
+      for(int m = 0; m < var_inds.size(); ++m) {
+
+            Rcpp::IntegerVector obs_rows = var_inds[m];
+
+            for(int k = 0; k < obs_rows.size(); ++k) {
+                  data_log_lik += emitmat(obs_rows[k], m + 1);
+            }
+      }
+
+      // tempered chains in replica exchange MCMC
+      if(obs_layout.containsElementNamed("inv_temperature")) {
+            data_log_lik *= Rcpp::as<double>(obs_layout["inv_temperature"]);
+      }
+
+      return data_log_lik;
+}
+
+// sum the observed entries of the emission matrix as in compute_data_log_lik, with the observation
+// rows of each variable and the inverse temperature taken from the observation layout beforehand.
+// does not call into R.
+double compute_data_log_lik_native(const arma::mat& emitmat,
+                                   const std::vector<arma::uvec>& var_rows,
+                                   double inv_temperature) {
+
+      double data_log_lik = 0;
+
+      for(unsigned int m = 0; m < var_rows.size(); ++m) {
+            for(unsigned int k = 0; k < var_rows[m].n_elem; ++k) {
+                  data_log_lik += emitmat(var_rows[m][k], m + 1);
+            }
+      }
+
+      return data_log_lik * inv_temperature;
+}
@@ -16,25 +16,29 @@ using namespace Rcpp;
 // [[Rcpp::export]]
 void compute_incidence(arma::mat& censusmat, arma::uvec& col_inds, Rcpp::List& row_inds) {
 
-        int n_vars = col_inds.size();           // number of incidence variables
-        int last_row = censusmat.n_rows - 1;    // index of the final row in the census matrix
+        int n_vars  = col_inds.size();           // number of incidence variables
+        int n_rows  = censusmat.n_rows;          // number of rows in the census matrix
 
         for(int k=0; k < n_vars; ++k) {
 
-                arma::uvec census_inds = row_inds[k];
-                int col_ind = col_inds[k];
-                int n_times = census_inds.n_elem;
+                const Rcpp::NumericVector census_inds = row_inds[k];
+                double* census_col = censusmat.colptr(col_inds[k]);
+                int n_times = census_inds.size();
 
-                if(census_inds[0] != 0) {
-                        censusmat(arma::span(0, census_inds[0]-1), col_ind).fill(0);
-                }
+                // carry the value at the last incidence row forward and difference it, in one pass
+                int next      = 0;
+                double held   = 0.0;
+                double prev   = 0.0;
 
-                for(int j=0; j < n_times - 1; ++j) {
-                        censusmat(arma::span(census_inds[j], census_inds[j+1]-1), col_ind).fill(censusmat(census_inds[j], col_ind));
-                }
+                for(int j=0; j < n_rows; ++j) {
 
-                censusmat(arma::span(census_inds[n_times - 1], last_row), col_ind).fill(censusmat(census_inds[n_times - 1], col_ind));
+                        if(next < n_times && census_inds[next] == j) {
+                                held = census_col[j];
+                                ++next;
+                        }
 
-                censusmat(arma::span(1, last_row), col_ind) = arma::diff(censusmat.col(col_ind));
+                        census_col[j] = (j == 0) ? held : held - prev;
+                        prev = held;
+                }
         }
 }
\ No newline at end of file
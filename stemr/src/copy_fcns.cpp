@@ -59,17 +59,18 @@ void copy_elem2(arma::rowvec& dest, const arma::rowvec& orig, const arma::uvec&
       dest.elem(inds) = orig.elem(inds);
 }
 
-//' Increment an element of a vector by 1
+//' Increment an element of a vector
 //'
 //' @param vec destination row vector
 //' @param ind C++ style index for the element to be copied
+//' @param amount increment, defaults to 1
 //'
-//' @return Add 1 to an element of a vector
+//' @return Add the increment to an element of a vector
 //' @export
 // [[Rcpp::export]]
-void increment_elem(arma::vec& vec, int ind) {
+void increment_elem(arma::vec& vec, int ind, double amount = 1) {
       
-      vec[ind] += 1;
+      vec[ind] += amount;
 }
 
 //' Copy the contents of one vector into another
@@ -0,0 +1,49 @@
+#ifndef stemr_double_buffer_h
+#define stemr_double_buffer_h
+
+#include <RcppArmadillo.h>
+#include <utility>
+
+// current and proposed states of a matrix held in the memory of two R matrices. proposals
+// are written to the proposal buffer and accepting a proposal swaps the buffers, so accepts
+// do not copy. the current state is written back to the R matrix that the caller treats as
+// current, once, when the buffers are synced or go out of scope.
+class double_buffer {
+
+public:
+      double_buffer(Rcpp::NumericMatrix& cur_R, Rcpp::NumericMatrix& prop_R) :
+            buf_cur(cur_R.begin(), cur_R.nrow(), cur_R.ncol(), false, true),
+            buf_prop(prop_R.begin(), prop_R.nrow(), prop_R.ncol(), false, true),
+            cur_ptr(&buf_cur),
+            prop_ptr(&buf_prop) {}
+
+      ~double_buffer() { sync(); }
+
+      // the buffers are views of R memory and may not be copied
+      double_buffer(const double_buffer&) = delete;
+      double_buffer& operator=(const double_buffer&) = delete;
+
+      arma::mat& cur() { return *cur_ptr; }
+      arma::mat& prop() { return *prop_ptr; }
+      const arma::mat& cur() const { return *cur_ptr; }
+      const arma::mat& prop() const { return *prop_ptr; }
+
+      // make the proposal the current state
+      void accept() { std::swap(cur_ptr, prop_ptr); }
+
+      // write the current state back to the current R matrix if it is held in the proposal buffer
+      void sync() {
+            if(cur_ptr != &buf_cur) {
+                  buf_cur = buf_prop;
+                  std::swap(cur_ptr, prop_ptr);
+            }
+      }
+
+private:
+      arma::mat buf_cur;
+      arma::mat buf_prop;
+      arma::mat* cur_ptr;
+      arma::mat* prop_ptr;
+};
+
+#endif
@@ -11,8 +11,8 @@ using namespace Rcpp;
 //' @param obsmat matrix containing the data
 //' @param statemat matrix containing the compartment counts at the observation
 //'   times
-//' @param measproc_indmat logical matrix indicating which compartments are
-//'   observed at every observation time
+//' @param obs_layout list with the compressed observation layout, see
+//'   \code{build_obs_layout}
 //' @param parameters numeric vector of parameter values
 //' @param constants numeric vector of constants
 //' @param tcovar_censusmat numeric vector of time-varying covariate values
@@ -21,16 +21,25 @@ using namespace Rcpp;
 //' @export
 // [[Rcpp::export]]
 void evaluate_d_measure(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat,
-                        const Rcpp::NumericMatrix& statemat, const Rcpp::LogicalMatrix& measproc_indmat,
+                        const Rcpp::NumericMatrix& statemat, const Rcpp::List& obs_layout,
                         const Rcpp::NumericVector& parameters, const Rcpp::NumericVector& constants,
                         const Rcpp::NumericMatrix& tcovar_censusmat, SEXP d_meas_ptr) {
 
-        // get dimensions
-        Rcpp::IntegerVector emit_dims = emitmat.attr("dim");
+        // variables observed at each observation time, in compressed row format
+        Rcpp::IntegerVector row_ptr  = obs_layout["row_ptr"];
+        Rcpp::IntegerVector col_inds = obs_layout["col_inds"];
+        Rcpp::IntegerVector obs_rows = obs_layout["obs_rows"];
+        Rcpp::LogicalVector emit_inds(emitmat.ncol() - 1);
+
+        // evaluate the densities at times when something was observed
+        for(int i=0; i < obs_rows.size(); ++i) {
+
+                int j = obs_rows[i];
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = true;
 
-        // evaluate the densities
-        for(int j=0; j < emit_dims[0]; ++j) {
                 // args: emitmat, emit_inds, record_ind, record, state, parameters, constants, tcovar, pointer
-                CALL_D_MEASURE(emitmat, measproc_indmat.row(j), j, obsmat.row(j), statemat.row(j), parameters, constants, tcovar_censusmat.row(j), d_meas_ptr);
+                CALL_D_MEASURE(emitmat, emit_inds, j, obsmat.row(j), statemat.row(j), parameters, constants, tcovar_censusmat.row(j), d_meas_ptr);
+
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = false;
         }
 }
\ No newline at end of file
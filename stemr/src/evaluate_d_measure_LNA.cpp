@@ -11,8 +11,8 @@ using namespace Rcpp;
 //' @param obsmat matrix containing the data
 //' @param censusmat matrix containing the state of the latent process at
 //'   observation times
-//' @param measproc_indmat logical matrix indicating which compartments are
-//'   observed at every observation time
+//' @param obs_layout list with the compressed observation layout, see
+//'   \code{build_obs_layout}
 //' @param lna_parameters matrix containing the LNA parameters, constants and
 //'   time-varying coariates.
 //' @param lna_param_vec container for storing the LNA parameters at each
@@ -25,20 +25,27 @@ using namespace Rcpp;
 //' @param census_indices vector of indices when the LNA path has been censused.
 //' @param lna_param_vec vector for keeping the current lna parameters
 //' @param d_meas_ptr external pointer to measurement process density function
+//' @param row_start C++ index of the first row of the emission matrix to be
+//'   recomputed, rows above it are left as is (see \code{find_dirty_range}).
 //'
 //' @export
 // [[Rcpp::export]]
 void evaluate_d_measure_LNA(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMatrix& obsmat,
-                        const Rcpp::NumericMatrix& censusmat, const Rcpp::LogicalMatrix& measproc_indmat,
+                        const Rcpp::NumericMatrix& censusmat, const Rcpp::List& obs_layout,
                         const Rcpp::NumericMatrix& lna_parameters, const Rcpp::IntegerVector& lna_param_inds,
                         const Rcpp::IntegerVector& lna_const_inds, const Rcpp::IntegerVector& lna_tcovar_inds,
                         const Rcpp::LogicalVector& param_update_inds, const Rcpp::IntegerVector& census_indices,
-                        Rcpp::NumericVector& lna_param_vec, SEXP d_meas_ptr) {
+                        Rcpp::NumericVector& lna_param_vec, SEXP d_meas_ptr, int row_start = 0) {
 
         // get constants
         int n_obstimes   = obsmat.nrow();
         int n_tcovar     = lna_tcovar_inds.size();
 
+        // variables observed at each observation time, in compressed row format
+        Rcpp::IntegerVector row_ptr  = obs_layout["row_ptr"];
+        Rcpp::IntegerVector col_inds = obs_layout["col_inds"];
+        Rcpp::LogicalVector emit_inds(emitmat.ncol() - 1);
+
         // initialize parameters and time-varying covariates/parameters
         std::copy(lna_parameters.row(0).begin(), 
                   lna_parameters.row(0).end(), 
@@ -55,9 +62,79 @@ void evaluate_d_measure_LNA(Rcpp::NumericMatrix& emitmat, const Rcpp::NumericMat
                                 lna_param_vec.end() - n_tcovar);
                 }
 
+                // rows before row_start are unchanged, but the parameters are still carried forward
+                // rows without observations have no emission probabilities
+                if(j < row_start || row_ptr[j] == row_ptr[j+1]) continue;
+
+                // flag the variables observed at time j
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = true;
+
                 // args: emitmat, emit_inds, record_ind, record, state, parameters, constants, tcovar, pointer
-                CALL_D_MEASURE(emitmat, measproc_indmat.row(j), j, obsmat.row(j), censusmat.row(j),
+                CALL_D_MEASURE(emitmat, emit_inds, j, obsmat.row(j), censusmat.row(j),
                                lna_param_vec[lna_param_inds], lna_param_vec[lna_const_inds], 
                                lna_param_vec[lna_tcovar_inds], d_meas_ptr);
+
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = false;
+        }
+}
+// evaluate the emission densities for a census matrix through the native density function, as in
+// evaluate_d_measure_LNA with row_start = 0. the observation layout is given by its row pointers
+// and column indices. does not call into R, so that emission matrices can be filled concurrently.
+void evaluate_d_measure_native(arma::mat& emitmat,
+                               const arma::mat& obsmat,
+                               const arma::mat& censusmat,
+                               const std::vector<int>& row_ptr,
+                               const std::vector<int>& col_inds,
+                               const arma::mat& lna_parameters,
+                               const arma::uvec& lna_param_inds,
+                               const arma::uvec& lna_const_inds,
+                               const arma::uvec& lna_tcovar_inds,
+                               const Rcpp::LogicalVector& param_update_inds,
+                               const Rcpp::IntegerVector& census_indices,
+                               d_measure_native_ptr d_meas_fcn) {
+
+        // get constants
+        int n_obstimes = obsmat.n_rows;
+        int n_pars     = lna_parameters.n_cols;
+        int n_tcovar   = lna_tcovar_inds.n_elem;
+
+        std::vector<int> emit_inds(emitmat.n_cols - 1, 0);
+        arma::rowvec emit_row(emitmat.n_cols);
+        arma::rowvec record(obsmat.n_cols);
+        arma::rowvec state(censusmat.n_cols);
+
+        // initialize parameters and time-varying covariates/parameters
+        arma::vec param_vec = arma::trans(lna_parameters.row(0));
+        arma::vec parameters, constants, tcovar;
+
+        // evaluate the densities
+        for(int j=0; j < n_obstimes; ++j) {
+
+                // update the model parameters if called for
+                // measurement process is right continuous, hence indexing by j+1, not j
+                if(param_update_inds[j] && n_tcovar > 0) {
+                      param_vec.tail(n_tcovar) =
+                            arma::trans(lna_parameters(census_indices[j+1], arma::span(n_pars - n_tcovar, n_pars - 1)));
+                }
+
+                // rows without observations have no emission probabilities
+                if(row_ptr[j] == row_ptr[j+1]) continue;
+
+                // flag the variables observed at time j
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = 1;
+
+                record     = obsmat.row(j);
+                state      = censusmat.row(j);
+                parameters = param_vec.elem(lna_param_inds);
+                constants  = param_vec.elem(lna_const_inds);
+                tcovar     = param_vec.elem(lna_tcovar_inds);
+
+                d_meas_fcn(emit_row.memptr(), emit_inds.data(), record.memptr(), state.memptr(),
+                           parameters.memptr(), constants.memptr(), tcovar.memptr());
+
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) {
+                      emitmat(j, col_inds[k] + 1) = emit_row[col_inds[k] + 1];
+                      emit_inds[col_inds[k]]      = 0;
+                }
         }
-}
\ No newline at end of file
+}
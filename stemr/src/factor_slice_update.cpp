@@ -0,0 +1,246 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "slice_target.h"
+#include <RcppArmadilloExtensions/sample.h>
+
+using namespace Rcpp;
+using namespace arma;
+
+// automated factor slice sampling updates along the sampled eigen-directions, shared by the LNA and ODE
+void factor_slice_update(slice_target& target,
+                         const Rcpp::IntegerVector& directions,
+                         const arma::mat& slice_eigenvecs,
+                         const arma::vec& interval_widths,
+                         arma::vec& n_contractions_afss,
+                         arma::vec& n_expansions_afss,
+                         arma::vec& c_contractions_afss,
+                         arma::vec& c_expansions_afss) {
+
+      for(int f : directions) {
+
+            // sample the likelihood threshold
+            double threshold = target.begin_update();
+
+            slice_line_counts counts =
+                  slice_line_update(target, threshold, arma::trans(slice_eigenvecs.col(f)), interval_widths[f]);
+
+            n_expansions_afss[f]   += counts.n_expansions;
+            c_expansions_afss[f]   += counts.n_expansions;
+            n_contractions_afss[f] += counts.n_contractions;
+            c_contractions_afss[f] += counts.n_contractions;
+      }
+}
+
+//' Update model parameters via automated factor slice sampling for a model
+//' fit via the LNA.
+//'
+//' The model parameters, path, likelihood terms, and adaptation counters are
+//' updated in place. Arguments are as in \code{\link{factor_slice_sampler}}.
+//'
+//' @inheritParams factor_slice_sampler
+//'
+//' @return update the model parameters, path, and likelihood terms in place
+//' @export
+// [[Rcpp::export]]
+void factor_slice_update_lna(Rcpp::NumericVector& model_params_est,
+                             Rcpp::NumericVector& model_params_nat,
+                             Rcpp::NumericVector& params_prop_est,
+                             Rcpp::NumericVector& params_prop_nat,
+                             const arma::vec& interval_widths,
+                             arma::vec& n_contractions_afss,
+                             arma::vec& n_expansions_afss,
+                             arma::vec& c_contractions_afss,
+                             arma::vec& c_expansions_afss,
+                             const arma::mat& slice_eigenvecs,
+                             const Rcpp::NumericVector& slice_probs,
+                             int n_afss_updates,
+                             const Rcpp::List& path,
+                             Rcpp::NumericMatrix& pathmat_prop,
+                             const Rcpp::NumericMatrix& data,
+                             const Rcpp::List& priors,
+                             Rcpp::NumericVector& params_logprior_cur,
+                             Rcpp::NumericMatrix& lna_params_cur,
+                             Rcpp::NumericVector& lna_param_vec,
+                             SEXP tparam,
+                             Rcpp::NumericMatrix& censusmat,
+                             Rcpp::NumericMatrix& emitmat,
+                             const arma::mat& flow_matrix,
+                             const arma::mat& stoich_matrix,
+                             const arma::rowvec& lna_times,
+                             const Rcpp::LogicalVector& forcing_inds,
+                             const arma::uvec& forcing_tcov_inds,
+                             const arma::mat& forcings_out,
+                             const arma::cube& forcing_transfers,
+                             const Rcpp::IntegerVector& lna_param_inds,
+                             const Rcpp::IntegerVector& lna_const_inds,
+                             const Rcpp::IntegerVector& lna_tcovar_inds,
+                             const Rcpp::IntegerVector& lna_initdist_inds,
+                             const arma::uvec& path_par_inds,
+                             const Rcpp::LogicalVector& param_update_inds,
+                             const arma::uvec& lna_event_inds,
+                             const Rcpp::IntegerVector& census_indices,
+                             const Rcpp::List& obs_layout,
+                             arma::vec& svd_d,
+                             arma::mat& svd_U,
+                             arma::mat& svd_V,
+                             SEXP lna_pointer,
+                             SEXP lna_set_pars_pointer,
+                             SEXP d_meas_pointer,
+                             bool do_prevalence,
+                             double step_size,
+                             SEXP slice_batch) {
+
+      // the current path, perturbations, and data log likelihood
+      Rcpp::NumericMatrix lna_path     = path["lna_path"];
+      Rcpp::NumericMatrix draws_R      = path["draws"];
+      Rcpp::NumericVector data_log_lik = path["data_log_lik"];
+      const arma::mat draws(draws_R.begin(), draws_R.nrow(), draws_R.ncol(), false, true);
+
+      path_mapper map_path = [&](arma::mat& pathmat) {
+            map_draws_2_lna(pathmat, draws, lna_times, lna_params_cur, lna_param_vec, lna_param_inds,
+                            lna_tcovar_inds, lna_initdist_inds[0], param_update_inds, stoich_matrix,
+                            forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                            svd_d, svd_U, svd_V, step_size, lna_pointer, lna_set_pars_pointer);
+      };
+
+      slice_target target(priors, Rf_isNull(tparam) ? Rcpp::List() : Rcpp::List(tparam),
+                          model_params_est, model_params_nat, params_prop_est, params_prop_nat,
+                          params_logprior_cur, data_log_lik, lna_params_cur, lna_param_vec,
+                          lna_path, pathmat_prop, censusmat, emitmat, data, obs_layout, flow_matrix,
+                          forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                          lna_param_inds, lna_const_inds, lna_tcovar_inds, lna_initdist_inds,
+                          path_par_inds, param_update_inds, lna_event_inds, census_indices,
+                          d_meas_pointer, do_prevalence, R_NilValue, map_path);
+
+      // evaluate the slice sampling candidates in concurrent batches through the native code
+      if(!Rf_isNull(slice_batch)) {
+            Rcpp::List batch_settings = slice_batch;
+            ode_native_ptr lna_native = *Rcpp::XPtr<ode_native_ptr>(Rcpp::as<SEXP>(batch_settings["path_native_ptr"]));
+            int n_tcovar              = lna_tcovar_inds.size();
+            int init_start            = lna_initdist_inds[0];
+
+            native_path_mapper map_native = [&, lna_native, n_tcovar, init_start](arma::mat& pathmat,
+                                                                                 const arma::mat& pars,
+                                                                                 path_workspace& workspace) {
+                  map_draws_2_lna_native(pathmat, draws, lna_times, pars, n_tcovar, init_start, param_update_inds,
+                                         stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                                         forcing_transfers, workspace.svd_d, workspace.svd_U, workspace.svd_V,
+                                         step_size, lna_native);
+            };
+
+            target.enable_batches(map_native, batch_settings["d_meas_native_ptr"],
+                                  Rcpp::as<int>(batch_settings["n_threads"]));
+      }
+
+      // sample the slice directions
+      Rcpp::IntegerVector directions =
+            Rcpp::RcppArmadillo::sample(Rcpp::IntegerVector(Rcpp::seq(0, slice_probs.size() - 1)),
+                                        n_afss_updates, false, slice_probs);
+
+      factor_slice_update(target, directions, slice_eigenvecs, interval_widths,
+                          n_contractions_afss, n_expansions_afss, c_contractions_afss, c_expansions_afss);
+}
+
+//' Update model parameters via automated factor slice sampling for a model
+//' fit via the ODE.
+//'
+//' The model parameters, path, likelihood terms, and adaptation counters are
+//' updated in place. Arguments are as in \code{\link{factor_slice_sampler_ode}}.
+//'
+//' @inheritParams factor_slice_sampler_ode
+//'
+//' @return update the model parameters, path, and likelihood terms in place
+//' @export
+// [[Rcpp::export]]
+void factor_slice_update_ode(Rcpp::NumericVector& model_params_est,
+                             Rcpp::NumericVector& model_params_nat,
+                             Rcpp::NumericVector& params_prop_est,
+                             Rcpp::NumericVector& params_prop_nat,
+                             const arma::vec& interval_widths,
+                             arma::vec& n_contractions_afss,
+                             arma::vec& n_expansions_afss,
+                             arma::vec& c_contractions_afss,
+                             arma::vec& c_expansions_afss,
+                             const arma::mat& slice_eigenvecs,
+                             const Rcpp::NumericVector& slice_probs,
+                             int n_afss_updates,
+                             const Rcpp::List& path,
+                             Rcpp::NumericMatrix& pathmat_prop,
+                             const Rcpp::NumericMatrix& data,
+                             const Rcpp::List& priors,
+                             Rcpp::NumericVector& params_logprior_cur,
+                             Rcpp::NumericMatrix& ode_params_cur,
+                             Rcpp::NumericVector& ode_param_vec,
+                             SEXP tparam,
+                             Rcpp::NumericMatrix& censusmat,
+                             Rcpp::NumericMatrix& emitmat,
+                             const arma::mat& flow_matrix,
+                             const arma::mat& stoich_matrix,
+                             const arma::rowvec& ode_times,
+                             const Rcpp::LogicalVector& forcing_inds,
+                             const arma::uvec& forcing_tcov_inds,
+                             const arma::mat& forcings_out,
+                             const arma::cube& forcing_transfers,
+                             const Rcpp::IntegerVector& ode_param_inds,
+                             const Rcpp::IntegerVector& ode_const_inds,
+                             const Rcpp::IntegerVector& ode_tcovar_inds,
+                             const Rcpp::IntegerVector& ode_initdist_inds,
+                             const arma::uvec& path_par_inds,
+                             SEXP ode_cache,
+                             const Rcpp::LogicalVector& param_update_inds,
+                             const arma::uvec& ode_event_inds,
+                             const Rcpp::IntegerVector& census_indices,
+                             const Rcpp::List& obs_layout,
+                             SEXP ode_pointer,
+                             SEXP ode_set_pars_pointer,
+                             SEXP d_meas_pointer,
+                             bool do_prevalence,
+                             double step_size,
+                             SEXP slice_batch) {
+
+      // the current path and data log likelihood
+      Rcpp::NumericMatrix ode_path     = path["ode_path"];
+      Rcpp::NumericVector data_log_lik = path["data_log_lik"];
+
+      path_mapper map_path = [&](arma::mat& pathmat) {
+            map_pars_2_ode_cached(ode_cache, path_par_inds, pathmat, ode_times, ode_params_cur, ode_param_inds,
+                                  ode_tcovar_inds, ode_initdist_inds[0], param_update_inds, stoich_matrix,
+                                  forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                                  step_size, ode_pointer, ode_set_pars_pointer);
+      };
+
+      slice_target target(priors, Rf_isNull(tparam) ? Rcpp::List() : Rcpp::List(tparam),
+                          model_params_est, model_params_nat, params_prop_est, params_prop_nat,
+                          params_logprior_cur, data_log_lik, ode_params_cur, ode_param_vec,
+                          ode_path, pathmat_prop, censusmat, emitmat, data, obs_layout, flow_matrix,
+                          forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                          ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds,
+                          path_par_inds, param_update_inds, ode_event_inds, census_indices,
+                          d_meas_pointer, do_prevalence, ode_cache, map_path);
+
+      // evaluate the slice sampling candidates in concurrent batches through the native code
+      if(!Rf_isNull(slice_batch)) {
+            Rcpp::List batch_settings = slice_batch;
+            ode_native_ptr ode_native = *Rcpp::XPtr<ode_native_ptr>(Rcpp::as<SEXP>(batch_settings["path_native_ptr"]));
+            int n_tcovar              = ode_tcovar_inds.size();
+            int init_start            = ode_initdist_inds[0];
+
+            native_path_mapper map_native = [&, ode_native, n_tcovar, init_start](arma::mat& pathmat,
+                                                                                 const arma::mat& pars,
+                                                                                 path_workspace& workspace) {
+                  map_pars_2_ode_native(pathmat, ode_times, pars, n_tcovar, init_start, param_update_inds,
+                                        stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                                        forcing_transfers, step_size, ode_native);
+            };
+
+            target.enable_batches(map_native, batch_settings["d_meas_native_ptr"],
+                                  Rcpp::as<int>(batch_settings["n_threads"]));
+      }
+
+      // sample the slice directions
+      Rcpp::IntegerVector directions =
+            Rcpp::RcppArmadillo::sample(Rcpp::IntegerVector(Rcpp::seq(0, slice_probs.size() - 1)),
+                                        n_afss_updates, false, slice_probs);
+
+      factor_slice_update(target, directions, slice_eigenvecs, interval_widths,
+                          n_contractions_afss, n_expansions_afss, c_contractions_afss, c_expansions_afss);
+}
@@ -0,0 +1,82 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include <RcppArmadillo.h>
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Find the first census interval affected by a change in the LNA path or the
+//' LNA parameters, and synchronize the reference objects.
+//'
+//' @param path_ref matrix with the path from which the census and emission
+//'   matrices were last computed
+//' @param path matrix with the newly mapped LNA path
+//' @param pars_ref matrix with the LNA parameters from which the census and
+//'   emission matrices were last computed
+//' @param lna_pars matrix with the current parameters, constants, and
+//'   time-varying covariates and parameters
+//' @param census_inds vector of indices for census interval endpoints
+//' @param reset if TRUE, the reference objects are overwritten and every
+//'   census interval is flagged as changed
+//'
+//' @return C++ row index of the first row of the census and emission matrices
+//'   that needs to be recomputed. Equal to the number of census intervals if
+//'   nothing changed. The changed rows are copied into path_ref and pars_ref.
+//' @export
+// [[Rcpp::export]]
+int find_dirty_range(arma::mat& path_ref,
+                     const arma::mat& path,
+                     arma::mat& pars_ref,
+                     const arma::mat& lna_pars,
+                     const arma::uvec& census_inds,
+                     bool reset) {
+
+      // get dimensions
+      int n_path_rows      = path.n_rows;
+      int n_par_rows       = lna_pars.n_rows;
+      int n_census_rows    = census_inds.n_elem - 1;
+
+      // first rows in the path and parameter matrices that differ from the references
+      int first_path_row = reset ? 0 : n_path_rows;
+      int first_par_row  = reset ? 0 : n_par_rows;
+
+      // scan the incidence columns, each is contiguous in memory
+      for(int c = 1; c < int(path.n_cols) && first_path_row > 0; ++c) {
+            for(int r = 0; r < first_path_row; ++r) {
+                  if(path(r, c) != path_ref(r, c)) {
+                        first_path_row = r;
+                        break;
+                  }
+            }
+      }
+
+      // scan the parameters, constants, and time-varying covariates
+      for(int c = 0; c < int(lna_pars.n_cols) && first_par_row > 0; ++c) {
+            for(int r = 0; r < first_par_row; ++r) {
+                  if(lna_pars(r, c) != pars_ref(r, c)) {
+                        first_par_row = r;
+                        break;
+                  }
+            }
+      }
+
+      // synchronize the references
+      if(first_path_row < n_path_rows) {
+            path_ref.rows(first_path_row, n_path_rows - 1) = path.rows(first_path_row, n_path_rows - 1);
+      }
+
+      if(first_par_row < n_par_rows) {
+            pars_ref.rows(first_par_row, n_par_rows - 1) = lna_pars.rows(first_par_row, n_par_rows - 1);
+      }
+
+      // the census row k-1 is affected by changes at or before the interval endpoint census_inds[k]
+      // parameters are carried forward, so a change at row r affects the same census rows
+      int census_start = n_census_rows;
+
+      if(first_path_row < n_path_rows || first_par_row < n_par_rows) {
+            arma::uword first_row = std::min(first_path_row, first_par_row);
+            census_start = std::lower_bound(census_inds.begin() + 1, census_inds.end(), first_row) -
+                  (census_inds.begin() + 1);
+      }
+
+      return census_start;
+}
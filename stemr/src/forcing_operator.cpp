@@ -0,0 +1,78 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "forcing_operator.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+forcing_operator::forcing_operator(const arma::mat& forcings_out, const arma::cube& forcing_transfers) {
+
+      unsigned int n_forcings = forcings_out.n_cols;
+      arma::uword max_sources = 0;
+
+      sources.resize(n_forcings);
+      source_weights.resize(n_forcings);
+      transfer_ptrs.resize(n_forcings);
+      transfer_dests.resize(n_forcings);
+      transfer_weights.resize(n_forcings);
+
+      for(unsigned int s = 0; s < n_forcings; ++s) {
+
+            // compartments with flow out and the nonzero entries of their transfer columns
+            sources[s]        = arma::find(forcings_out.col(s));
+            source_weights[s] = forcings_out.elem(sources[s] + s * forcings_out.n_rows);
+
+            const arma::mat& transfers = forcing_transfers.slice(s);
+            std::vector<unsigned int> ptrs(1, 0), dests;
+            std::vector<double> weights;
+
+            for(unsigned int a = 0; a < sources[s].n_elem; ++a) {
+                  for(unsigned int i = 0; i < transfers.n_rows; ++i) {
+                        if(transfers(i, sources[s][a]) != 0) {
+                              dests.push_back(i);
+                              weights.push_back(transfers(i, sources[s][a]));
+                        }
+                  }
+                  ptrs.push_back(dests.size());
+            }
+
+            transfer_ptrs[s]    = arma::conv_to<arma::uvec>::from(ptrs);
+            transfer_dests[s]   = arma::conv_to<arma::uvec>::from(dests);
+            transfer_weights[s] = arma::conv_to<arma::vec>::from(weights);
+
+            max_sources = std::max(max_sources, sources[s].n_elem);
+      }
+
+      flows.zeros(max_sources);
+}
+
+void forcing_operator::distribute(const double* volumes, int s, double flow, bool round_flows) const {
+
+      const arma::uvec& src = sources[s];
+      const arma::vec& wts  = source_weights[s];
+
+      // flows are proportional to the weighted volumes, normalised as by normalise(x, 1)
+      double total = 0;
+      for(unsigned int a = 0; a < src.n_elem; ++a) {
+            flows[a] = wts[a] * volumes[src[a]];
+            total   += std::abs(flows[a]);
+      }
+
+      double scale = flow / ((total != 0) ? total : 1.0);
+      for(unsigned int a = 0; a < src.n_elem; ++a) {
+            flows[a] *= scale;
+            if(round_flows) flows[a] = std::round(flows[a]);
+      }
+}
+
+void forcing_operator::transfer(double* volumes, int s) const {
+
+      const arma::uvec& ptrs    = transfer_ptrs[s];
+      const arma::uvec& dests   = transfer_dests[s];
+      const arma::vec& weights  = transfer_weights[s];
+
+      for(unsigned int a = 0; a + 1 < ptrs.n_elem; ++a) {
+            for(unsigned int k = ptrs[a]; k < ptrs[a+1]; ++k) {
+                  volumes[dests[k]] += weights[k] * flows[a];
+            }
+      }
+}
@@ -0,0 +1,41 @@
+#ifndef stemr_forcing_operator_h
+#define stemr_forcing_operator_h
+
+#include <RcppArmadillo.h>
+#include <vector>
+
+// sparse form of the forcings, parsed once from forcings_out and forcing_transfers. each forcing
+// removes its flow from the source compartments in proportion to their volumes, weighted by
+// forcings_out, and moves it to the destinations given by the nonzero entries of the columns of
+// its transfer matrix. applying a forcing costs the number of sources and transfers rather than
+// a dense product with the n_comps x n_comps transfer matrix.
+class forcing_operator {
+
+public:
+      forcing_operator(const arma::mat& forcings_out, const arma::cube& forcing_transfers);
+
+      // apply forcing s with total flow to a vector of compartment volumes, in place. the flows
+      // out of each source are rounded if round_flows, as for integer compartment counts.
+      void apply(double* volumes, int s, double flow, bool round_flows = false) const {
+            distribute(volumes, s, flow, round_flows);
+            transfer(volumes, s);
+      }
+
+      // compute the flows out of the sources of forcing s given the compartment volumes
+      void distribute(const double* volumes, int s, double flow, bool round_flows = false) const;
+
+      // add the last flows computed by distribute to a vector of compartment volumes
+      void transfer(double* volumes, int s) const;
+
+      int n_forcings() const { return sources.size(); }
+
+private:
+      std::vector<arma::uvec> sources;        // compartments that forcing s draws from
+      std::vector<arma::vec> source_weights;  // entries of forcings_out for the sources
+      std::vector<arma::uvec> transfer_ptrs;  // offsets of the transfers of each source
+      std::vector<arma::uvec> transfer_dests; // destination compartments
+      std::vector<arma::vec> transfer_weights;
+      mutable arma::vec flows;                // flows out of the sources of the last forcing
+};
+
+#endif
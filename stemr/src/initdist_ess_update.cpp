@@ -0,0 +1,349 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "stemr_utils.h"
+#include "double_buffer.h"
+#include "tparam_block.h"
+#include <functional>
+
+using namespace Rcpp;
+using namespace arma;
+
+// the initial compartment volumes of a stratum, with views of the draws that determine them
+class initdist_block {
+
+public:
+      explicit initdist_block(const Rcpp::List& initdist_object) :
+            draws_cur_R(initdist_object["draws_cur"]),
+            draws_prop_R(initdist_object["draws_prop"]),
+            draws_ess_R(initdist_object["draws_ess"]),
+            draws_cur(draws_cur_R.begin(), draws_cur_R.size(), false, true),
+            draws_prop(draws_prop_R.begin(), draws_prop_R.size(), false, true),
+            draws_ess(draws_ess_R.begin(), draws_ess_R.size(), false, true),
+            comp_mean(Rcpp::as<arma::vec>(initdist_object["comp_mean"])),
+            comp_sqrt_cov(Rcpp::as<arma::mat>(initdist_object["comp_sqrt_cov"])),
+            comp_inds(Rcpp::as<arma::uvec>(initdist_object["comp_inds_Cpp"])),
+            comp_size(Rcpp::as<double>(initdist_object["comp_size"])) {}
+
+      // draw new perturbations that define the ellipse
+      void draw_ellipse() { draw_normals(draws_prop); }
+
+      // map the draws at an angle on the ellipse to the proposed volumes, false if out of bounds
+      bool propose(double theta, arma::rowvec& volumes_prop) {
+
+            draws_ess = std::cos(theta) * draws_cur + std::sin(theta) * draws_prop;
+            volumes   = comp_mean + comp_sqrt_cov * draws_ess;
+
+            volumes_prop.elem(comp_inds) = volumes;
+
+            return volumes.min() >= 0 && volumes.max() <= comp_size;
+      }
+
+      void accept(arma::rowvec& volumes_cur) {
+            draws_cur = draws_ess;
+            volumes_cur.elem(comp_inds) = volumes;
+      }
+
+private:
+      Rcpp::NumericVector draws_cur_R;
+      Rcpp::NumericVector draws_prop_R;
+      Rcpp::NumericVector draws_ess_R;
+      arma::vec draws_cur;
+      arma::vec draws_prop;
+      arma::vec draws_ess;
+      arma::vec comp_mean;
+      arma::mat comp_sqrt_cov;
+      arma::uvec comp_inds;
+      double comp_size;
+      arma::vec volumes;
+};
+
+typedef std::vector<std::unique_ptr<initdist_block>> initdist_blocks;
+
+// blocks for the strata whose initial volumes are not fixed
+static initdist_blocks get_initdist_blocks(const Rcpp::List& initdist_objects) {
+
+      initdist_blocks blocks;
+      for(int s = 0; s < initdist_objects.size(); ++s) {
+            Rcpp::List initdist_object = initdist_objects[s];
+            if(!Rcpp::as<bool>(initdist_object["fixed"])) blocks.emplace_back(new initdist_block(initdist_object));
+      }
+
+      return blocks;
+}
+
+// elliptical slice sampling updates of the initial compartment volumes, shared by the LNA and
+// ODE. the volumes are bounds checked before any path is computed, then inserted into the first
+// row of the parameter matrix along with the time-varying parameters that may depend on them.
+// proposal_loglik maps the path into the proposal buffer and returns the data log likelihood.
+static void initdist_ess(initdist_blocks& blocks,
+                         tparam_blocks& tblocks,
+                         arma::mat& pars,
+                         arma::rowvec& volumes_cur,
+                         arma::rowvec& volumes_prop,
+                         int initdist_start,
+                         double_buffer& path,
+                         Rcpp::NumericVector& data_log_lik,
+                         const std::function<double(arma::mat&)>& proposal_loglik,
+                         Rcpp::NumericVector& initdist_steps,
+                         Rcpp::NumericVector& initdist_angle,
+                         double initdist_bracket_width,
+                         int n_initdist_updates) {
+
+      const double min_width = std::sqrt(arma::datum::eps);
+      double step_count = 1.0;
+
+      // propose at an angle on the ellipse
+      auto evaluate = [&](double theta) {
+
+            bool in_bounds = true;
+            for(auto& b : blocks) in_bounds = b->propose(theta, volumes_prop) && in_bounds;
+
+            if(!in_bounds) return R_NegInf;
+
+            pars2lnapars2(pars, volumes_prop, initdist_start);
+            for(auto& t : tblocks) t->restore(pars);
+
+            return proposal_loglik(path.prop());
+      };
+
+      for(int k = 0; k < n_initdist_updates; ++k) {
+
+            // choose a likelihood threshold
+            double threshold = data_log_lik[0] + std::log(R::unif_rand());
+
+            // initial proposal, which also defines a bracket
+            double lower = -initdist_bracket_width * R::unif_rand();
+            double upper = lower + initdist_bracket_width;
+            double theta = R::runif(lower, upper);
+
+            for(auto& b : blocks) b->draw_ellipse();
+            double loglik = evaluate(theta);
+
+            // continue proposing if not accepted
+            while((upper - lower) > min_width && loglik < threshold) {
+
+                  step_count += 1;
+
+                  // shrink the bracket and sample a new point
+                  if(theta < 0) {
+                        lower = theta;
+                  } else {
+                        upper = theta;
+                  }
+
+                  theta  = R::runif(lower, upper);
+                  loglik = evaluate(theta);
+            }
+
+            // if the bracket width is not equal to zero, update the draws, path, and data log likelihood
+            if((upper - lower) > min_width) {
+                  for(auto& b : blocks) b->accept(volumes_cur);
+                  path.accept();
+                  data_log_lik[0] = loglik;
+
+            } else {
+                  pars2lnapars2(pars, volumes_cur, initdist_start);
+                  for(auto& t : tblocks) t->restore(pars);
+            }
+
+            initdist_steps[0] = step_count;
+            initdist_angle[0] = theta;
+      }
+}
+
+//' Update the initial compartment volumes of an LNA model via elliptical slice
+//' sampling, natively.
+//'
+//' Time-varying parameters, if any, must have compiled structures, see
+//' \code{\link{tpar_structure}}. The draws, volumes, path, and likelihood terms
+//' are updated in place, with the path sharing the current and proposal
+//' buffers of the latent path sampler. Arguments are as in
+//' \code{\link{update_initdist_lna}}.
+//'
+//' @inheritParams update_initdist_lna
+//'
+//' @return update the initial volumes and the path in place
+//' @export
+// [[Rcpp::export]]
+void initdist_ess_update_lna(const Rcpp::List& initdist_objects,
+                             Rcpp::NumericVector& init_volumes_cur,
+                             Rcpp::NumericVector& init_volumes_prop,
+                             const Rcpp::List& path_cur,
+                             const Rcpp::NumericMatrix& data,
+                             Rcpp::NumericMatrix& lna_parameters,
+                             Rcpp::NumericVector& lna_param_vec,
+                             const Rcpp::List& tparam,
+                             Rcpp::NumericMatrix& pathmat_prop,
+                             Rcpp::NumericMatrix& censusmat,
+                             Rcpp::NumericMatrix& emitmat,
+                             const arma::mat& flow_matrix,
+                             const arma::mat& stoich_matrix,
+                             const arma::rowvec& lna_times,
+                             const Rcpp::LogicalVector& forcing_inds,
+                             const arma::uvec& forcing_tcov_inds,
+                             const arma::mat& forcings_out,
+                             const arma::cube& forcing_transfers,
+                             const Rcpp::IntegerVector& lna_param_inds,
+                             const Rcpp::IntegerVector& lna_const_inds,
+                             const Rcpp::IntegerVector& lna_tcovar_inds,
+                             const Rcpp::IntegerVector& lna_initdist_inds,
+                             const Rcpp::LogicalVector& param_update_inds,
+                             const Rcpp::IntegerVector& census_indices,
+                             const arma::uvec& lna_event_inds,
+                             const Rcpp::List& obs_layout,
+                             arma::vec& svd_d,
+                             arma::mat& svd_U,
+                             arma::mat& svd_V,
+                             SEXP lna_pointer,
+                             SEXP lna_set_pars_pointer,
+                             SEXP d_meas_pointer,
+                             bool do_prevalence,
+                             double step_size,
+                             Rcpp::NumericVector& initdist_steps,
+                             Rcpp::NumericVector& initdist_angle,
+                             double initdist_bracket_width,
+                             int n_initdist_updates) {
+
+      // the current path, perturbations, and data log likelihood
+      Rcpp::NumericMatrix lna_path     = path_cur["lna_path"];
+      Rcpp::NumericMatrix draws_R      = path_cur["draws"];
+      Rcpp::NumericVector data_log_lik = path_cur["data_log_lik"];
+      const arma::mat draws(draws_R.begin(), draws_R.nrow(), draws_R.ncol(), false, true);
+
+      arma::mat pars(lna_parameters.begin(), lna_parameters.nrow(), lna_parameters.ncol(), false, true);
+      arma::mat census(censusmat.begin(), censusmat.nrow(), censusmat.ncol(), false, true);
+      arma::mat emit(emitmat.begin(), emitmat.nrow(), emitmat.ncol(), false, true);
+      arma::rowvec volumes_cur(init_volumes_cur.begin(), init_volumes_cur.size(), false, true);
+      arma::rowvec volumes_prop(init_volumes_prop.begin(), init_volumes_prop.size(), false, true);
+      arma::uvec census_inds = Rcpp::as<arma::uvec>(census_indices);
+
+      std::function<double(arma::mat&)> proposal_loglik = [&](arma::mat& pathmat) {
+
+            double loglik = R_NegInf;
+
+            try {
+                  // the whole path changes with the initial volumes, census it as it is mapped
+                  map_draws_2_lna_census(pathmat, draws, lna_times, lna_parameters, lna_param_vec, lna_param_inds,
+                                         lna_tcovar_inds, lna_initdist_inds[0], param_update_inds, stoich_matrix,
+                                         forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                                         svd_d, svd_U, svd_V, step_size, lna_pointer, lna_set_pars_pointer,
+                                         census, census_inds, lna_event_inds, flow_matrix, do_prevalence,
+                                         volumes_prop, true);
+
+                  evaluate_d_measure_LNA(emitmat, data, censusmat, obs_layout, lna_parameters, lna_param_inds,
+                                         lna_const_inds, lna_tcovar_inds, param_update_inds, census_indices,
+                                         lna_param_vec, d_meas_pointer, 0);
+
+                  loglik = compute_data_log_lik(emit, obs_layout);
+                  if(ISNAN(loglik)) loglik = R_NegInf;
+
+            } catch(std::exception&) {
+                  loglik = R_NegInf;
+            }
+
+            return loglik;
+      };
+
+      initdist_blocks blocks = get_initdist_blocks(initdist_objects);
+      tparam_blocks tblocks  = get_tparam_blocks(tparam);
+      double_buffer path(lna_path, pathmat_prop);
+
+      initdist_ess(blocks, tblocks, pars, volumes_cur, volumes_prop, lna_initdist_inds[0], path,
+                   data_log_lik, proposal_loglik, initdist_steps, initdist_angle,
+                   initdist_bracket_width, n_initdist_updates);
+}
+
+//' Update the initial compartment volumes of an ODE model via elliptical slice
+//' sampling, natively.
+//'
+//' Time-varying parameters, if any, must have compiled structures, see
+//' \code{\link{tpar_structure}}. The draws, volumes, path, and likelihood terms
+//' are updated in place. Arguments are as in \code{\link{update_initdist_ode}}.
+//'
+//' @inheritParams update_initdist_ode
+//'
+//' @return update the initial volumes and the path in place
+//' @export
+// [[Rcpp::export]]
+void initdist_ess_update_ode(const Rcpp::List& initdist_objects,
+                             Rcpp::NumericVector& init_volumes_cur,
+                             Rcpp::NumericVector& init_volumes_prop,
+                             const Rcpp::List& path_cur,
+                             const Rcpp::NumericMatrix& data,
+                             Rcpp::NumericMatrix& ode_parameters,
+                             Rcpp::NumericVector& ode_param_vec,
+                             const Rcpp::List& tparam,
+                             Rcpp::NumericMatrix& pathmat_prop,
+                             Rcpp::NumericMatrix& censusmat,
+                             Rcpp::NumericMatrix& emitmat,
+                             const arma::mat& flow_matrix,
+                             const arma::mat& stoich_matrix,
+                             const arma::rowvec& ode_times,
+                             const Rcpp::LogicalVector& forcing_inds,
+                             const arma::uvec& forcing_tcov_inds,
+                             const arma::mat& forcings_out,
+                             const arma::cube& forcing_transfers,
+                             const Rcpp::IntegerVector& ode_param_inds,
+                             const Rcpp::IntegerVector& ode_const_inds,
+                             const Rcpp::IntegerVector& ode_tcovar_inds,
+                             const Rcpp::IntegerVector& ode_initdist_inds,
+                             const Rcpp::LogicalVector& param_update_inds,
+                             const Rcpp::IntegerVector& census_indices,
+                             const arma::uvec& ode_event_inds,
+                             const Rcpp::List& obs_layout,
+                             SEXP ode_pointer,
+                             SEXP ode_set_pars_pointer,
+                             SEXP d_meas_pointer,
+                             bool do_prevalence,
+                             double step_size,
+                             Rcpp::NumericVector& initdist_steps,
+                             Rcpp::NumericVector& initdist_angle,
+                             double initdist_bracket_width,
+                             int n_initdist_updates) {
+
+      // the current path and data log likelihood
+      Rcpp::NumericMatrix ode_path     = path_cur["ode_path"];
+      Rcpp::NumericVector data_log_lik = path_cur["data_log_lik"];
+
+      arma::mat pars(ode_parameters.begin(), ode_parameters.nrow(), ode_parameters.ncol(), false, true);
+      arma::mat census(censusmat.begin(), censusmat.nrow(), censusmat.ncol(), false, true);
+      arma::mat emit(emitmat.begin(), emitmat.nrow(), emitmat.ncol(), false, true);
+      arma::rowvec volumes_cur(init_volumes_cur.begin(), init_volumes_cur.size(), false, true);
+      arma::rowvec volumes_prop(init_volumes_prop.begin(), init_volumes_prop.size(), false, true);
+      arma::uvec census_inds = Rcpp::as<arma::uvec>(census_indices);
+
+      std::function<double(arma::mat&)> proposal_loglik = [&](arma::mat& pathmat) {
+
+            double loglik = R_NegInf;
+
+            try {
+                  map_pars_2_ode(pathmat, ode_times, ode_parameters, ode_param_inds, ode_tcovar_inds,
+                                 ode_initdist_inds[0], param_update_inds, stoich_matrix, forcing_inds,
+                                 forcing_tcov_inds, forcings_out, forcing_transfers, step_size,
+                                 ode_pointer, ode_set_pars_pointer);
+
+                  census_lna(pathmat, census, census_inds, ode_event_inds, flow_matrix, do_prevalence,
+                             volumes_prop, pars, forcing_inds, forcing_tcov_inds, forcings_out,
+                             forcing_transfers, 0);
+
+                  evaluate_d_measure_LNA(emitmat, data, censusmat, obs_layout, ode_parameters, ode_param_inds,
+                                         ode_const_inds, ode_tcovar_inds, param_update_inds, census_indices,
+                                         ode_param_vec, d_meas_pointer, 0);
+
+                  loglik = compute_data_log_lik(emit, obs_layout);
+                  if(ISNAN(loglik)) loglik = R_NegInf;
+
+            } catch(std::exception&) {
+                  loglik = R_NegInf;
+            }
+
+            return loglik;
+      };
+
+      initdist_blocks blocks = get_initdist_blocks(initdist_objects);
+      tparam_blocks tblocks  = get_tparam_blocks(tparam);
+      double_buffer path(ode_path, pathmat_prop);
+
+      initdist_ess(blocks, tblocks, pars, volumes_cur, volumes_prop, ode_initdist_inds[0], path,
+                   data_log_lik, proposal_loglik, initdist_steps, initdist_angle,
+                   initdist_bracket_width, n_initdist_updates);
+}
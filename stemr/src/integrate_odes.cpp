@@ -1,6 +1,7 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include "stemr_types.h"
 #include "stemr_utils.h"
+#include "forcing_operator.h"
 
 using namespace Rcpp;
 using namespace arma;
@@ -53,7 +54,7 @@ Rcpp::List integrate_odes(const arma::rowvec& ode_times,
         
         // for use with forcings
         double forcing_flow = 0;
-        arma::vec forcing_distvec(n_comps, arma::fill::zeros);
+        forcing_operator forcing_op(forcings_out, forcing_transfers);
         
         // initialize the objects used in each time interval
         double t_L = 0;
@@ -81,8 +82,7 @@ Rcpp::List integrate_odes(const arma::rowvec& ode_times,
               for(int j=0; j < n_forcings; ++j) {
                     
                     forcing_flow       = ode_pars(0, forcing_tcov_inds[j]);
-                    forcing_distvec    = forcing_flow * normalise(forcings_out.col(j) % init_volumes, 1);
-                    init_volumes      += forcing_transfers.slice(j) * forcing_distvec;
+                    forcing_op.apply(init_volumes.memptr(), j, forcing_flow);
               }
         }
 
@@ -111,8 +111,7 @@ Rcpp::List integrate_odes(const arma::rowvec& ode_times,
                       for(int s=0; s < n_forcings; ++s) {
                             
                             forcing_flow       = ode_pars(j+1, forcing_tcov_inds[s]);
-                            forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                            init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                            forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                       }
                 }
 
@@ -0,0 +1,148 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#define ARMA_DONT_PRINT_ERRORS
+#include "stemr_types.h"
+#include "stemr_utils.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Rank-one update of a Cholesky factor
+//'
+//' @param R upper triangular cholesky factor of a matrix A, replaced in place
+//'   with the cholesky factor of A + x x'
+//' @param x vector for the rank-one update
+//'
+//' @return update the cholesky factor in place
+//' @export
+// [[Rcpp::export]]
+void chol_update(arma::mat& R, arma::vec x) {
+
+      arma::uword n = R.n_rows;
+
+      for(arma::uword k = 0; k < n; ++k) {
+
+            double r = std::hypot(R(k,k), x[k]);
+            double c = r / R(k,k);
+            double s = x[k] / R(k,k);
+            R(k,k)   = r;
+
+            for(arma::uword j = k + 1; j < n; ++j) {
+                  R(k,j) = (R(k,j) + s * x[j]) / c;
+                  x[j]   = c * x[j] - s * R(k,j);
+            }
+      }
+}
+
+//' Update the empirical mean and covariance of an adaptive kernel, and the
+//' cholesky factor of the covariance
+//'
+//' The covariance is updated as kernel_cov + adaptation * (r r' - kernel_cov),
+//' where r is the residual of the parameters from the current mean, which is
+//' the Welford update when adaptation = 1/n. The cholesky factor is rescaled
+//' and updated with the residual in O(p^2) operations. It is recomputed from
+//' the covariance if the adaptation factor is one or the update fails.
+//'
+//' @param kernel_mean vector with the empirical mean
+//' @param kernel_cov empirical covariance matrix
+//' @param kernel_chol upper triangular cholesky factor of the covariance, or
+//'   a 0x0 matrix if it is not needed
+//' @param kernel_resid vector in which to store the residual
+//' @param params_est vector of model parameters on the estimation scale
+//' @param adaptation adaptation factor
+//'
+//' @return update the mean, covariance, residual and cholesky factor in place
+//' @export
+// [[Rcpp::export]]
+void update_kernel_cov(arma::vec& kernel_mean,
+                       arma::mat& kernel_cov,
+                       arma::mat& kernel_chol,
+                       arma::vec& kernel_resid,
+                       const arma::vec& params_est,
+                       double adaptation) {
+
+      // update the mean and covariance
+      kernel_resid = params_est - kernel_mean;
+      kernel_cov  *= 1 - adaptation;
+      kernel_cov  += adaptation * kernel_resid * kernel_resid.t();
+      kernel_mean += adaptation * kernel_resid;
+
+      if(kernel_chol.n_elem == 0) return;
+
+      // rank-one update of the cholesky factor
+      bool updated = adaptation < 1;
+
+      if(updated) {
+            kernel_chol *= std::sqrt(1 - adaptation);
+            chol_update(kernel_chol, std::sqrt(adaptation) * kernel_resid);
+
+            updated = kernel_chol.is_finite() && arma::all(kernel_chol.diag() > 0);
+      }
+
+      // otherwise compute the cholesky from scratch
+      if(!updated) {
+            arma::mat cov_copy(kernel_cov);
+            comp_chol(kernel_chol, cov_copy);
+      }
+}
+
+//' Update the eigenvalues of the slice factors for a rank-one change in the
+//' empirical covariance
+//'
+//' The eigenvalues are replaced by the Rayleigh quotients of the updated
+//' covariance at the current eigenvectors, see \code{\link{update_kernel_cov}}.
+//'
+//' @param slice_eigenvals vector of eigenvalues
+//' @param slice_eigenvecs matrix of eigenvectors
+//' @param kernel_resid residual used to update the covariance
+//' @param adaptation adaptation factor used to update the covariance
+//'
+//' @return update the eigenvalues in place
+//' @export
+// [[Rcpp::export]]
+void track_factors(arma::vec& slice_eigenvals,
+                   const arma::mat& slice_eigenvecs,
+                   const arma::vec& kernel_resid,
+                   double adaptation) {
+
+      slice_eigenvals = (1 - adaptation) * slice_eigenvals +
+            adaptation * arma::square(slice_eigenvecs.t() * kernel_resid);
+}
+
+//' Update slice factor directions via a step of subspace iteration
+//'
+//' The current eigenvectors are refined by one step of orthogonal iteration
+//' and the eigenvalues are set to the Rayleigh quotients, avoiding a full
+//' eigen decomposition. The factors are kept in ascending order of their
+//' eigenvalues, as returned by \code{\link{update_factors}}.
+//'
+//' @param slice_eigenvals vector of eigenvalues
+//' @param slice_eigenvecs matrix of eigenvectors
+//' @param kernel_cov empirical covariance matrix of model params
+//'
+//' @return update eigenvalues and eigenvectors in place
+//' @export
+// [[Rcpp::export]]
+void update_factors_subspace(arma::vec& slice_eigenvals,
+                             arma::mat& slice_eigenvecs,
+                             const arma::mat& kernel_cov) {
+
+      // the leading columns of the QR factorization converge to the largest factors
+      arma::mat Q, R;
+      bool success = arma::qr_econ(Q, R, kernel_cov * arma::fliplr(slice_eigenvecs));
+
+      if(!success || !Q.is_finite()) {
+            update_factors(slice_eigenvals, slice_eigenvecs, kernel_cov);
+            return;
+      }
+
+      // keep the orientation of the factors
+      for(arma::uword j = 0; j < Q.n_cols; ++j) {
+            if(R(j,j) < 0) Q.col(j) *= -1;
+      }
+
+      slice_eigenvecs = arma::fliplr(Q);
+      slice_eigenvals = arma::sum(slice_eigenvecs % (kernel_cov * slice_eigenvecs), 0).t();
+
+      // double check that all eigenvalues are non-negative
+      slice_eigenvals.elem(arma::find(slice_eigenvals < 0)).zeros();
+}
@@ -1,5 +1,6 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include <RcppArmadillo.h>
+#include "forcing_operator.h"
 using namespace arma;
 using namespace Rcpp;
 
@@ -35,7 +36,7 @@ arma::mat lna_incid2prev(const arma::mat& path,
       
       // for use with forcings
       double forcing_flow = 0;
-      arma::rowvec forcing_distvec(n_comps, arma::fill::zeros);
+      forcing_operator forcing_op(forcings_out, forcing_transfers);
       
       // initialize an object for the coverted path
       arma::mat conv_path(n_times, n_comps+1, arma::fill::zeros);
@@ -51,8 +52,7 @@ arma::mat lna_incid2prev(const arma::mat& path,
             for(int s=0; s < n_forcings; ++s) {
                   
                   forcing_flow     = forcing_matrix(0, forcing_tcov_inds[s]);
-                  forcing_distvec  = (forcing_flow * normalise(forcings_out.col(s) % volumes.t(), 1)).t();
-                  volumes         += (forcing_transfers.slice(s) * forcing_distvec.t()).t();
+                  forcing_op.apply(volumes.memptr(), s, forcing_flow);
             }
       }
       
@@ -68,8 +68,7 @@ arma::mat lna_incid2prev(const arma::mat& path,
                   // distribute the forcings proportionally to the compartment counts in the applicable states
                   for(int s=0; s < n_forcings; ++s) {
                         forcing_flow     = forcing_matrix(k, forcing_tcov_inds[s]);
-                        forcing_distvec  = (forcing_flow * normalise(forcings_out.col(s) % volumes.t(), 1)).t();
-                        volumes         += (forcing_transfers.slice(s) * forcing_distvec.t()).t();
+                        forcing_op.apply(volumes.memptr(), s, forcing_flow);
                   }
             }
       }
@@ -1,7 +1,6 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #define ARMA_DONT_PRINT_ERRORS
-#include "stemr_types.h"
-#include "stemr_utils.h"
+#include "path_integrators.h"
 
 using namespace Rcpp;
 using namespace arma;
@@ -57,172 +56,45 @@ void map_draws_2_lna(arma::mat& pathmat,
                      SEXP lna_pointer,
                      SEXP set_pars_pointer) {
 
-        // get the dimensions of various objects
-        int n_events = stoich_matrix.n_cols;         // number of transition events, e.g., S2I, I2R
-        int n_comps  = stoich_matrix.n_rows;         // number of model compartments (all strata)
-        int n_odes   = n_events + n_events*n_events; // number of ODEs
-        int n_times  = lna_times.n_elem;             // number of times at which the LNA must be evaluated
-        int n_tcovar = lna_tcovar_inds.size();       // number of time-varying covariates or parameters
-        int n_forcings = forcing_tcov_inds.n_elem;   // number of forcings
-        
-        // for use with forcings
-        double forcing_flow = 0;
-        arma::vec forcing_distvec(n_comps, arma::fill::zeros);
-        
-        // initialize the objects used in each time interval
-        double t_L = 0;
-        double t_R = 0;
-
-        // vector of parameters, initial compartment columes, constants, and time-varying covariates
-        std::copy(lna_pars.row(0).begin(), lna_pars.row(0).end(), lna_param_vec.begin());
-
-        CALL_SET_ODE_PARAMS(lna_param_vec, set_pars_pointer); // set the parameters in the odeintr namespace
-
-        // initial state vector - copy elements from the current parameter vector
-        arma::vec init_volumes(lna_param_vec.begin() + init_start, n_comps);
-
-        // initialize the LNA objects
-        bool good_svd = true;
-
-        Rcpp::NumericVector lna_state_vec(n_odes); // the vector for storing the current state of the LNA ODEs
-
-        arma::vec lna_drift(n_events, arma::fill::zeros);               // incidence mean vector (log scale)
-        arma::mat lna_diffusion(n_events, n_events, arma::fill::zeros); // diffusion matrix
-
-        arma::vec log_lna(n_events, arma::fill::zeros);  // LNA increment, log scale
-        arma::vec nat_lna(n_events, arma::fill::zeros);  // LNA increment, natural scale
-
-        // apply forcings if called for - applied after censusing at the first time
-        if(forcing_inds[0]) {
-              
-              // distribute the forcings proportionally to the compartment counts in the applicable states
-              for(int j=0; j < n_forcings; ++j) {
-                    
-                    forcing_flow       = lna_pars(0, forcing_tcov_inds[j]);
-                    forcing_distvec    = forcing_flow * normalise(forcings_out.col(j) % init_volumes, 1);
-                    init_volumes      += forcing_transfers.slice(j) * forcing_distvec;
-              }
-        }
-
-        // iterate over the time sequence, solving the LNA over each interval
-        for(int j=0; j < (n_times-1); ++j) {
-
-                // set the times of the interval endpoints
-                t_L = lna_times[j];
-                t_R = lna_times[j+1];
-
-                // Reset the LNA state vector and integrate the LNA ODEs over the next interval to 0
-                std::fill(lna_state_vec.begin(), lna_state_vec.end(), 0.0);
-                CALL_INTEGRATE_STEM_ODE(lna_state_vec, t_L, t_R, step_size, lna_pointer);
-
-                // transfer the elements of the lna_state_vec to the process objects
-                std::copy(lna_state_vec.begin(), lna_state_vec.begin() + n_events, lna_drift.begin());
-                std::copy(lna_state_vec.begin() + n_events, lna_state_vec.end(), lna_diffusion.begin());
-
-                // ensure symmetry of the diffusion matrix
-                lna_diffusion = arma::symmatu(lna_diffusion);
-
-                // map the stochastic perturbation to the LNA path on its natural scale
-                try{
-                        if(lna_drift.has_nan() || lna_diffusion.has_nan()) {
-                                good_svd = false;
-                                throw std::runtime_error("Integration failed.");
-                        } else {
-                                good_svd = arma::svd(svd_U, svd_d, svd_V, lna_diffusion); // compute the SVD
-                        }
-
-                        if(!good_svd) {
-                                throw std::runtime_error("SVD failed.");
-
-                        } else {
-                                svd_d.elem(arma::find(svd_d < 0)).zeros();          // zero out negative sing. vals
-                                svd_V.each_row() %= arma::sqrt(svd_d).t();          // multiply rows of V by sqrt(d)
-                                svd_U *= svd_V.t();                                 // complete svd_sqrt
-                                svd_U.elem(arma::find(lna_diffusion == 0)).zeros(); // zero out numerical errors
-
-                                log_lna = lna_drift + svd_U * draws.col(j);         // map the LNA draws
-                        }
-
-                } catch(std::exception & err) {
-
-                        // reinstatiate the SVD objects
-                        arma::vec svd_d(n_events, arma::fill::zeros);
-                        arma::mat svd_U(n_events, n_events, arma::fill::zeros);
-                        arma::mat svd_V(n_events, n_events, arma::fill::zeros);
-
-                        // forward the exception
-                        forward_exception_to_r(err);
-
-                } catch(...) {
-                        ::Rf_error("c++ exception (unknown reason)");
-                }
-
-                // compute the LNA increment
-                nat_lna = arma::vec(expm1(Rcpp::NumericVector(log_lna.begin(), log_lna.end())));
-
-                // save the LNA increment
-                pathmat(j+1, arma::span(1, n_events)) = nat_lna.t();
-
-                // update the initial volumes
-                init_volumes += stoich_matrix * nat_lna;
-
-                // if any increments or volumes are negative, throw an error
-                try{
-                        if(any(nat_lna < 0)) {
-                                throw std::runtime_error("Negative increment.");
-                        }
-
-                        if(any(init_volumes < 0)) {
-                                throw std::runtime_error("Negative compartment volumes.");
-                        }
-
-                } catch(std::runtime_error &err) {
-
-                        forward_exception_to_r(err);
-
-                } catch(...) {
-                        ::Rf_error("c++ exception (unknown reason)");
-                }
-                
-                // apply forcings if called for - applied after censusing the path
-                if(forcing_inds[j+1]) {
-                      
-                      // distribute the forcings proportionally to the compartment counts in the applicable states
-                      for(int s=0; s < n_forcings; ++s) {
-                            
-                            forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                            forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                            init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                      }
-                      
-                      // throw errors for negative negative volumes
-                      try{
-                            if(any(init_volumes < 0)) {
-                                  throw std::runtime_error("Negative compartment volumes.");
-                            }
-                            
-                      } catch(std::exception &err) {
-                            
-                            forward_exception_to_r(err);
-                            
-                      } catch(...) {
-                            ::Rf_error("c++ exception (unknown reason)");
-                      }
-                }
-
-                // update the parameters if they need to be updated
-                if(param_update_inds[j+1]) {
-                      
-                      // time-varying covariates and parameters
-                      std::copy(lna_pars.row(j+1).end() - n_tcovar,
-                                lna_pars.row(j+1).end(),
-                                lna_param_vec.end() - n_tcovar);
-                }
-
-                // copy the new initial volumes into the vector of parameters
-                std::copy(init_volumes.begin(), init_volumes.end(), lna_param_vec.begin() + init_start);
-
-                // set the lna parameters and reset the LNA state vector
-                CALL_SET_ODE_PARAMS(lna_param_vec, set_pars_pointer);
-        }
-}
\ No newline at end of file
+        // the fused mapper with an empty census
+        arma::mat census_path;
+
+        map_draws_2_lna_census(pathmat, draws, lna_times, lna_pars, lna_param_vec, lna_param_inds,
+                               lna_tcovar_inds, init_start, param_update_inds, stoich_matrix,
+                               forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                               svd_d, svd_U, svd_V, step_size, lna_pointer, set_pars_pointer,
+                               census_path, arma::uvec(), arma::uvec(), arma::mat(), false,
+                               arma::rowvec(), true);
+}
+
+// map N(0,1) draws to an LNA path through the native integrator of the compiled LNA code. does
+// not call into R, so paths can be mapped concurrently, errors are thrown as std::runtime_error.
+void map_draws_2_lna_native(arma::mat& pathmat,
+                            const arma::mat& draws,
+                            const arma::rowvec& lna_times,
+                            const arma::mat& lna_pars,
+                            const int n_tcovar,
+                            const int init_start,
+                            const Rcpp::LogicalVector& param_update_inds,
+                            const arma::mat& stoich_matrix,
+                            const Rcpp::LogicalVector& forcing_inds,
+                            const arma::uvec& forcing_tcov_inds,
+                            const arma::mat& forcings_out,
+                            const arma::cube& forcing_transfers,
+                            arma::vec& svd_d,
+                            arma::mat& svd_U,
+                            arma::mat& svd_V,
+                            double step_size,
+                            ode_native_ptr lna_native) {
+
+        int n_events = stoich_matrix.n_cols;
+        std::vector<double> lna_param_vec(lna_pars.n_cols);
+        native_integrator integrator(lna_native, n_events + n_events*n_events, step_size);
+
+        arma::mat census_path;
+
+        map_draws_2_lna_path(pathmat, draws, lna_times, lna_pars, lna_param_vec.data(), n_tcovar, init_start,
+                             param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                             forcing_transfers, svd_d, svd_U, svd_V, census_path, arma::uvec(), arma::uvec(),
+                             arma::mat(), false, arma::rowvec(), true, integrator);
+}
@@ -0,0 +1,104 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#define ARMA_DONT_PRINT_ERRORS
+#include "path_integrators.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Map N(0,1) stochastic perturbations to an LNA path and census it in the
+//' same pass.
+//'
+//' Fused version of \code{\link{map_draws_2_lna}} followed by
+//' \code{\link{census_lna}} with \code{census_start = 0}. The census
+//' incidence and, if called for, the compartment volumes at census times are
+//' accumulated into the census matrix as each interval is solved, so the path
+//' is not scanned again. If \code{store_path} is FALSE, the path matrix is not
+//' written and may be empty, e.g., when only the likelihood is needed. If
+//' \code{census_inds} is empty, the path is not censused and the census
+//' arguments are not used, which is how \code{\link{map_draws_2_lna}} maps a
+//' path on its own.
+//'
+//' @param pathmat matrix where the LNA path should be stored
+//' @param draws matrix of N(0,1) draws to be mapped to an LNA path
+//' @param lna_times vector of interval endpoint times
+//' @param lna_pars numeric matrix of parameters, constants, and time-varying
+//'   covariates at each of the lna_times
+//' @param init_start index in the parameter vector where the initial compartment
+//'   volumes start
+//' @param param_update_inds logical vector indicating at which of the times the
+//'   LNA parameters need to be updated.
+//' @param stoich_matrix stoichiometry matrix giving the changes to compartments
+//'   from each reaction
+//' @param forcing_inds logical vector of indicating at which times in the
+//'   time-varying covariance matrix a forcing is applied.
+//' @param forcing_matrix matrix containing the forcings.
+//' @param svd_d vector in which to store SVD singular values
+//' @param svd_U matrix in which to store the U matrix of the SVD
+//' @param svd_V matrix in which to store the V matrix of the SVD
+//' @param step_size initial step size for the ODE solver (adapted internally,
+//' but too large of an initial step can lead to failure in stiff systems).
+//' @param lna_pointer external pointer to LNA integration function.
+//' @param set_pars_pointer external pointer to the function for setting the LNA
+//'   parameters.
+//' @param census_path matrix to be filled out with the censused path.
+//' @param census_inds vector of indices for census interval endpoints.
+//' @param lna_event_inds vector of column indices in the path matrix for events
+//'   that should be censused.
+//' @param flow_matrix_lna matrix containing the flow matrix for the LNA (no
+//'   incidence)
+//' @param do_prevalence should the prevalence be computed
+//' @param init_state the initial compartment counts
+//' @param store_path should the LNA path be stored in pathmat
+//'
+//' @return fill out pathmat with the LNA path corresponding to the stochastic
+//'   perturbations and the census matrix with its census.
+//'
+//' @export
+// [[Rcpp::export]]
+void map_draws_2_lna_census(arma::mat& pathmat,
+                            const arma::mat& draws,
+                            const arma::rowvec& lna_times,
+                            const Rcpp::NumericMatrix& lna_pars,
+                            Rcpp::NumericVector& lna_param_vec,
+                            const Rcpp::IntegerVector& lna_param_inds,
+                            const Rcpp::IntegerVector& lna_tcovar_inds,
+                            const int init_start,
+                            const Rcpp::LogicalVector& param_update_inds,
+                            const arma::mat& stoich_matrix,
+                            const Rcpp::LogicalVector& forcing_inds,
+                            const arma::uvec& forcing_tcov_inds,
+                            const arma::mat& forcings_out,
+                            const arma::cube& forcing_transfers,
+                            arma::vec& svd_d,
+                            arma::mat& svd_U,
+                            arma::mat& svd_V,
+                            double step_size,
+                            SEXP lna_pointer,
+                            SEXP set_pars_pointer,
+                            arma::mat& census_path,
+                            const arma::uvec& census_inds,
+                            const arma::uvec& lna_event_inds,
+                            const arma::mat& flow_matrix_lna,
+                            bool do_prevalence,
+                            const arma::rowvec& init_state,
+                            bool store_path = true) {
+
+        // the LNA ODEs are integrated through the odeintr namespace, whose parameters are set from lna_param_vec
+        int n_events = stoich_matrix.n_cols;
+        odeintr_integrator integrator(lna_param_vec, n_events + n_events*n_events, step_size, lna_pointer, set_pars_pointer);
+
+        const arma::mat pars(const_cast<double*>(lna_pars.begin()), lna_pars.nrow(), lna_pars.ncol(), false, true);
+
+        try{
+                map_draws_2_lna_path(pathmat, draws, lna_times, pars, lna_param_vec.begin(), lna_tcovar_inds.size(),
+                                     init_start, param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds,
+                                     forcings_out, forcing_transfers, svd_d, svd_U, svd_V, census_path, census_inds,
+                                     lna_event_inds, flow_matrix_lna, do_prevalence, init_state, store_path, integrator);
+
+        } catch(std::exception &err) {
+                forward_exception_to_r(err);
+
+        } catch(...) {
+                ::Rf_error("c++ exception (unknown reason)");
+        }
+}
@@ -1,6 +1,5 @@
 // [[Rcpp::depends(RcppArmadillo)]]
-#include "stemr_types.h"
-#include "stemr_utils.h"
+#include "path_integrators.h"
 
 using namespace Rcpp;
 using namespace arma;
@@ -47,97 +46,46 @@ void map_pars_2_ode(arma::mat& pathmat,
                     SEXP ode_pointer,
                     SEXP set_pars_pointer) {
 
-        // get the dimensions of various objects
-        int n_events = stoich_matrix.n_cols;         // number of transition events, e.g., S2I, I2R
-        int n_comps  = stoich_matrix.n_rows;         // number of model compartments (all strata)
-        int n_times  = ode_times.n_elem;             // number of times at which the ODEs must be evaluated
-        int n_tcovar = ode_tcovar_inds.size();       // number of time-varying covariates or parameters
-        int n_forcings = forcing_tcov_inds.n_elem;   // number of forcings
-        
-        // for use with forcings
-        double forcing_flow = 0;
-        arma::vec forcing_distvec(n_comps, arma::fill::zeros);
+        // the ODEs are integrated through the odeintr namespace, whose parameters are set from current_params
+        Rcpp::NumericVector current_params(ode_pars.ncol());
+        odeintr_integrator integrator(current_params, stoich_matrix.n_cols, step_size, ode_pointer, set_pars_pointer);
 
-        // initialize the objects used in each time interval
-        double t_L = 0;
-        double t_R = 0;
-        Rcpp::NumericVector current_params = ode_pars.row(0);   // vector for storing the current parameter values
-        CALL_SET_ODE_PARAMS(current_params, set_pars_pointer);  // set the parameters in the odeintr namespace
+        const arma::mat pars(const_cast<double*>(ode_pars.begin()), ode_pars.nrow(), ode_pars.ncol(), false, true);
 
-        // initial state vector - copy elements from the current parameter vector
-        arma::vec init_volumes(current_params.begin() + init_start, n_comps);
+        try{
+                map_pars_2_ode_path(pathmat, ode_times, pars, current_params.begin(), ode_tcovar_inds.size(),
+                                    init_start, param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds,
+                                    forcings_out, forcing_transfers, integrator);
 
-        // initialize the ODE objects - the vector for storing the current state
-        Rcpp::NumericVector ode_state_vec(n_events);   // vector to store the ODEs
+        } catch(std::exception &err) {
+                forward_exception_to_r(err);
 
-        // apply forcings if called for - applied after censusing at the first time
-        if(forcing_inds[0]) {
-              
-              // distribute the forcings proportionally to the compartment counts in the applicable states
-              for(int j=0; j < n_forcings; ++j) {
-                    
-                    forcing_flow       = ode_pars(0, forcing_tcov_inds[j]);
-                    forcing_distvec    = forcing_flow * normalise(forcings_out.col(j) % init_volumes, 1);
-                    init_volumes      += forcing_transfers.slice(j) * forcing_distvec;
-              }
+        } catch(...) {
+                ::Rf_error("c++ exception (unknown reason)");
         }
-
-        // iterate over the time sequence, solving the ODEs over each interval
-        for(int j=0; j < (n_times-1); ++j) {
-
-                // set the times of the interval endpoints
-                t_L = ode_times[j];
-                t_R = ode_times[j+1];
-
-                // Reset the ODE state vector and integrate the ODEs over the next interval
-                std::fill(ode_state_vec.begin(), ode_state_vec.end(), 0.0);
-                CALL_INTEGRATE_STEM_ODE(ode_state_vec, t_L, t_R, step_size, ode_pointer);
-
-                // compute the compartment volumes
-                init_volumes += stoich_matrix * Rcpp::as<arma::vec>(ode_state_vec);
-
-                // Save the increment and volumes
-                pathmat(j+1, arma::span(1, n_events)) = Rcpp::as<arma::rowvec>(ode_state_vec);
-
-                // apply forcings if called for - applied after censusing the path
-                if(forcing_inds[j+1]) {
-                      
-                      // distribute the forcings proportionally to the compartment counts in the applicable states
-                      for(int s=0; s < n_forcings; ++s) {
-                            
-                            forcing_flow       = ode_pars(j+1, forcing_tcov_inds[s]);
-                            forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                            init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                      }
-                }
-
-                // ensure the initial volumes are non-negative
-                try{
-                        if(any(init_volumes < 0)) {
-                                throw std::runtime_error("Negative compartment volumes.");
-                        }
-
-                } catch(std::runtime_error &err) {
-                        forward_exception_to_r(err);
-
-                } catch(...) {
-                        ::Rf_error("c++ exception (unknown reason)");
-                }
-
-                // update the parameters if they need to be updated
-                if(param_update_inds[j+1]) {
-                      
-                      // time-varying covariates and parameters
-                      std::copy(ode_pars.row(j+1).end() - n_tcovar,
-                                ode_pars.row(j+1).end(),
-                                current_params.end() - n_tcovar);
-                      
-                }
-
-                // copy the compartment volumes to the current parameters
-                std::copy(init_volumes.begin(), init_volumes.end(), current_params.begin() + init_start);
-
-                // set the ODE parameters and reset the ODE state vector
-                CALL_SET_ODE_PARAMS(current_params, set_pars_pointer);
-        }
-}
\ No newline at end of file
+}
+
+// map parameters to the deterministic mean incidence increments through the native integrator of
+// the compiled ODE code. does not call into R, so paths can be mapped concurrently, errors are
+// thrown as std::runtime_error.
+void map_pars_2_ode_native(arma::mat& pathmat,
+                           const arma::rowvec& ode_times,
+                           const arma::mat& ode_pars,
+                           const int n_tcovar,
+                           const int init_start,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::mat& stoich_matrix,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           double step_size,
+                           ode_native_ptr ode_native) {
+
+        std::vector<double> current_params(ode_pars.n_cols);
+        native_integrator integrator(ode_native, stoich_matrix.n_cols, step_size);
+
+        map_pars_2_ode_path(pathmat, ode_times, ode_pars, current_params.data(), n_tcovar, init_start,
+                            param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                            forcing_transfers, integrator);
+}
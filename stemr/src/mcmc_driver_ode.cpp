@@ -0,0 +1,244 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "slice_target.h"
+#include <fstream>
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Run the MCMC for a model fit via the ODE with the mvn_rw or mvn_g_adaptive
+//' kernel.
+//'
+//' The iterations, adaptation of the global scaling and empirical covariance,
+//' and recording of thinned samples are carried out natively, with the same
+//' sequence of updates as the R implementation in
+//' \code{\link{stem_inference_ode}}. The initial compartment volumes and t0
+//' must be fixed and there may not be time-varying parameters. The priors are
+//' evaluated through the compiled prior densities if supplied, and through the
+//' R prior functions otherwise. Iterations are numbered from 2 as in the R
+//' implementation.
+//'
+//' @param iterations number of MCMC iterations
+//' @param thin_params thinning interval for the parameter samples
+//' @param thin_latent_proc thinning interval for the latent paths
+//' @param progress_interval interval at which progress is appended to the
+//'   status file, 0 for no progress reports
+//' @param status_file name of the status file
+//' @param kernel_cov_chol cholesky factor of the proposal covariance, updated
+//'   in place for the adaptive kernel
+//' @param adaptive_kernel NULL for the mvn_rw kernel, otherwise a list with the
+//'   state and settings of the mvn_g_adaptive kernel: kernel_chol, kernel_mean,
+//'   kernel_cov, kernel_resid, adaptations, proposal_scaling, nugget,
+//'   max_scaling, target_g, stop_adaptation, adaptation_scale_record, and
+//'   kernel_cov_record. The vectors and matrices are updated in place.
+//' @param parameter_samples_nat matrix in which to record the parameters on
+//'   their natural scales, only the columns of the model parameters are written
+//' @param parameter_samples_est matrix in which to record the parameters on
+//'   their estimation scales
+//' @param data_log_lik_record vector in which to record the data log likelihood
+//' @param params_log_prior_record vector in which to record the log prior
+//' @param ode_paths array in which to record the latent paths
+//' @param param_rec_ind C++ index of the first parameter record
+//' @param path_rec_ind C++ index of the first path record
+//' @inheritParams factor_slice_sampler_ode
+//'
+//' @return list with the number of accepted proposals and the global proposal
+//'   scaling. The model parameters, path, likelihood terms, and records are
+//'   updated in place.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List mcmc_driver_ode(int iterations,
+                           int thin_params,
+                           int thin_latent_proc,
+                           int progress_interval,
+                           const std::string& status_file,
+                           arma::mat& kernel_cov_chol,
+                           SEXP adaptive_kernel,
+                           Rcpp::NumericMatrix& parameter_samples_nat,
+                           Rcpp::NumericMatrix& parameter_samples_est,
+                           Rcpp::NumericVector& data_log_lik_record,
+                           Rcpp::NumericVector& params_log_prior_record,
+                           Rcpp::NumericVector& ode_paths,
+                           int param_rec_ind,
+                           int path_rec_ind,
+                           Rcpp::NumericVector& model_params_est,
+                           Rcpp::NumericVector& model_params_nat,
+                           Rcpp::NumericVector& params_prop_est,
+                           Rcpp::NumericVector& params_prop_nat,
+                           const Rcpp::List& path,
+                           Rcpp::NumericMatrix& pathmat_prop,
+                           const Rcpp::NumericMatrix& data,
+                           const Rcpp::List& priors,
+                           Rcpp::NumericVector& params_logprior_cur,
+                           Rcpp::NumericMatrix& ode_params_cur,
+                           Rcpp::NumericVector& ode_param_vec,
+                           Rcpp::NumericMatrix& censusmat,
+                           Rcpp::NumericMatrix& emitmat,
+                           const arma::mat& flow_matrix,
+                           const arma::mat& stoich_matrix,
+                           const arma::rowvec& ode_times,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           const Rcpp::IntegerVector& ode_param_inds,
+                           const Rcpp::IntegerVector& ode_const_inds,
+                           const Rcpp::IntegerVector& ode_tcovar_inds,
+                           const Rcpp::IntegerVector& ode_initdist_inds,
+                           const arma::uvec& path_par_inds,
+                           SEXP ode_cache,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::uvec& ode_event_inds,
+                           const Rcpp::IntegerVector& census_indices,
+                           const Rcpp::List& obs_layout,
+                           SEXP ode_pointer,
+                           SEXP ode_set_pars_pointer,
+                           SEXP d_meas_pointer,
+                           bool do_prevalence,
+                           double step_size) {
+
+      // the current path and data log likelihood
+      Rcpp::NumericMatrix ode_path     = path["ode_path"];
+      Rcpp::NumericVector data_log_lik = path["data_log_lik"];
+
+      path_mapper map_path = [&](arma::mat& pathmat) {
+            map_pars_2_ode_cached(ode_cache, path_par_inds, pathmat, ode_times, ode_params_cur, ode_param_inds,
+                                  ode_tcovar_inds, ode_initdist_inds[0], param_update_inds, stoich_matrix,
+                                  forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                                  step_size, ode_pointer, ode_set_pars_pointer);
+      };
+
+      slice_target target(priors, Rcpp::List(), model_params_est, model_params_nat, params_prop_est,
+                          params_prop_nat, params_logprior_cur, data_log_lik, ode_params_cur, ode_param_vec,
+                          ode_path, pathmat_prop, censusmat, emitmat, data, obs_layout, flow_matrix,
+                          forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                          ode_param_inds, ode_const_inds, ode_tcovar_inds, ode_initdist_inds,
+                          path_par_inds, param_update_inds, ode_event_inds, census_indices,
+                          d_meas_pointer, do_prevalence, ode_cache, map_path);
+
+      // records
+      int n_model_params = model_params_est.size();
+      arma::mat samples_nat(parameter_samples_nat.begin(), parameter_samples_nat.nrow(),
+                            parameter_samples_nat.ncol(), false, true);
+      arma::mat samples_est(parameter_samples_est.begin(), parameter_samples_est.nrow(),
+                            parameter_samples_est.ncol(), false, true);
+      arma::cube path_record(ode_paths.begin(), ode_path.nrow(), ode_path.ncol(),
+                             ode_paths.size() / ode_path.size(), false, true);
+
+      // state and settings of the adaptive kernel, empty for the random walk kernel
+      bool adaptive = !Rf_isNull(adaptive_kernel);
+      Rcpp::List adaptive_list = adaptive ? Rcpp::List(adaptive_kernel) : Rcpp::List();
+
+      Rcpp::NumericMatrix chol_R  = adaptive ? Rcpp::as<Rcpp::NumericMatrix>(adaptive_list["kernel_chol"]) : Rcpp::NumericMatrix(0, 0);
+      Rcpp::NumericMatrix cov_R   = adaptive ? Rcpp::as<Rcpp::NumericMatrix>(adaptive_list["kernel_cov"])  : Rcpp::NumericMatrix(0, 0);
+      Rcpp::NumericVector mean_R  = adaptive ? Rcpp::as<Rcpp::NumericVector>(adaptive_list["kernel_mean"])  : Rcpp::NumericVector(0);
+      Rcpp::NumericVector resid_R = adaptive ? Rcpp::as<Rcpp::NumericVector>(adaptive_list["kernel_resid"]) : Rcpp::NumericVector(0);
+      Rcpp::NumericVector adapt_R = adaptive ? Rcpp::as<Rcpp::NumericVector>(adaptive_list["adaptations"])  : Rcpp::NumericVector(0);
+      Rcpp::NumericVector scale_R = adaptive ? Rcpp::as<Rcpp::NumericVector>(adaptive_list["adaptation_scale_record"]) : Rcpp::NumericVector(0);
+      Rcpp::NumericVector covrec  = adaptive ? Rcpp::as<Rcpp::NumericVector>(adaptive_list["kernel_cov_record"]) : Rcpp::NumericVector(0);
+
+      arma::mat kernel_chol(chol_R.begin(), chol_R.nrow(), chol_R.ncol(), false, true);
+      arma::mat kernel_cov(cov_R.begin(), cov_R.nrow(), cov_R.ncol(), false, true);
+      arma::vec kernel_mean(mean_R.begin(), mean_R.size(), false, true);
+      arma::vec kernel_resid(resid_R.begin(), resid_R.size(), false, true);
+      arma::vec adaptations(adapt_R.begin(), adapt_R.size(), false, true);
+      arma::vec scale_record(scale_R.begin(), scale_R.size(), false, true);
+      arma::cube kernel_cov_record(covrec.begin(), adaptive ? n_model_params : 0, adaptive ? n_model_params : 0,
+                                   adaptive ? covrec.size() / (n_model_params * n_model_params) : 0, false, true);
+
+      double proposal_scaling = adaptive ? Rcpp::as<double>(adaptive_list["proposal_scaling"]) : 1;
+      double nugget           = adaptive ? Rcpp::as<double>(adaptive_list["nugget"])           : 0;
+      double max_scaling      = adaptive ? Rcpp::as<double>(adaptive_list["max_scaling"])      : R_PosInf;
+      double target_g         = adaptive ? Rcpp::as<double>(adaptive_list["target_g"])         : 0;
+      int stop_adaptation     = adaptive ? Rcpp::as<int>(adaptive_list["stop_adaptation"])     : 0;
+
+      arma::rowvec params_prop(n_model_params);
+      double acceptances_g = 0;
+
+      std::ofstream status;
+      if(progress_interval > 0) status.open(status_file.c_str(), std::ios::app);
+
+      for(int iter = 2; iter <= iterations + 1; ++iter) {
+
+            // propose new parameters
+            if(adaptive && (iter == stop_adaptation || iter == iterations + 1)) {
+                  arma::mat sigma = proposal_scaling * kernel_cov;
+                  comp_chol(kernel_cov_chol, sigma);
+            }
+
+            if(adaptive && iter < stop_adaptation) {
+                  mvn_g_adaptive(params_prop, target.params_est(), kernel_cov_chol, nugget * adaptations[iter - 1]);
+            } else {
+                  mvn_rw(params_prop, target.params_est(), kernel_cov_chol);
+            }
+
+            // compute the acceptance probability
+            target.set_reference();
+            double logpost_cur  = target.log_lik() + target.log_prior();
+            double logpost_prop = target.log_posterior(params_prop);
+            double acceptance_prob = logpost_prop - logpost_cur;
+            if(ISNAN(acceptance_prob)) acceptance_prob = R_NegInf;
+
+            // accept/reject via metropolis-hastings
+            if(acceptance_prob >= 0 || acceptance_prob >= std::log(R::unif_rand())) {
+                  acceptances_g += 1;
+                  target.accept();
+            } else {
+                  target.restore();
+            }
+
+            // adapt the proposal kernel
+            if(adaptive && iter < stop_adaptation) {
+
+                  double adaptation = adaptations[iter - 1];
+
+                  proposal_scaling =
+                        std::min(std::exp(std::log(proposal_scaling) +
+                                          adaptation * (std::min(std::exp(acceptance_prob), 1.0) - target_g)),
+                                 max_scaling);
+
+                  update_kernel_cov(kernel_mean, kernel_cov, kernel_chol, kernel_resid,
+                                    arma::trans(target.params_est()), adaptation);
+
+                  kernel_cov_chol = std::sqrt(proposal_scaling) * kernel_chol;
+            }
+
+            // save the latent process if called for in this iteration
+            if(iter % thin_latent_proc == 0 && path_rec_ind < (int)path_record.n_slices) {
+                  path_record.slice(path_rec_ind++) = target.path_cur();
+            }
+
+            // save the parameters if called for in this iteration
+            if(iter % thin_params == 0 && param_rec_ind < (int)samples_est.n_rows) {
+
+                  data_log_lik_record[param_rec_ind]     = target.log_lik();
+                  params_log_prior_record[param_rec_ind] = target.log_prior();
+
+                  samples_nat(param_rec_ind, arma::span(0, n_model_params - 1)) = target.params_nat();
+                  samples_est(param_rec_ind, arma::span(0, n_model_params - 1)) = target.params_est();
+
+                  if(adaptive) {
+                        scale_record[param_rec_ind]            = proposal_scaling;
+                        kernel_cov_record.slice(param_rec_ind) = kernel_cov;
+                  }
+
+                  ++param_rec_ind;
+            }
+
+            // print status messages if called for
+            if(progress_interval > 0 && (iter - 1) % progress_interval == 0) {
+
+                  status << "Iteration: " << iter - 1 << "\n";
+
+                  if(adaptive && iter < stop_adaptation) {
+                        status << "Global acceptances: " << acceptances_g << "\n"
+                               << "Global acceptance rate: " << acceptances_g / (iter - 1) << "\n";
+                  }
+
+                  status.flush();
+                  Rcpp::checkUserInterrupt();
+            }
+      }
+
+      return Rcpp::List::create(Rcpp::Named("acceptances_g")    = acceptances_g,
+                                Rcpp::Named("proposal_scaling") = proposal_scaling);
+}
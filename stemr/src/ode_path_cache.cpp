@@ -0,0 +1,269 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "stemr_types.h"
+#include "stemr_utils.h"
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+using namespace Rcpp;
+using namespace arma;
+
+// an ODE path, keyed on the columns of the parameter matrix that determine it, and
+// the log likelihood at the last full parameter matrix evaluated with that path
+struct ode_cache_entry {
+      std::size_t key_hash;
+      arma::mat key;
+      arma::mat path;
+      arma::mat loglik_pars;
+      double loglik;
+      bool has_loglik;
+};
+
+// bounded least recently used cache, most recently used entries are at the front. the paths
+// depend on the initial time of the ODEs, which is not a column of the parameter matrix, so
+// the cache records the initial time of its entries and is cleared when the time changes.
+class ode_path_cache {
+
+public:
+      ode_path_cache(int capacity) : capacity(std::max(capacity, 1)),
+      path_hits(0), path_misses(0), loglik_hits(0), loglik_misses(0), origin(NA_REAL) {}
+
+      // set the initial time of the ODEs, discarding the entries computed from another time
+      void set_origin(double t0) {
+            if(t0 == origin) return;
+
+            entries.clear();
+            index.clear();
+            origin = t0;
+      }
+
+      // find the entry for a parameter matrix and mark it as most recently used
+      ode_cache_entry* find(const arma::mat& ode_pars, const arma::uvec& key_inds, std::size_t key_hash) {
+
+            auto it = index.find(key_hash);
+            if(it == index.end() || !key_matches(it->second->key, ode_pars, key_inds)) return nullptr;
+
+            entries.splice(entries.begin(), entries, it->second);
+            return &entries.front();
+      }
+
+      // insert a path, evicting the least recently used entry if the cache is full
+      void insert(const arma::mat& ode_pars, const arma::uvec& key_inds, std::size_t key_hash, const arma::mat& path) {
+
+            auto it = index.find(key_hash);
+            if(it != index.end()) {
+                  entries.erase(it->second);
+                  index.erase(it);
+
+            } else if(int(entries.size()) == capacity) {
+                  index.erase(entries.back().key_hash);
+                  entries.pop_back();
+            }
+
+            entries.push_front(ode_cache_entry{key_hash, ode_pars.cols(key_inds), path, arma::mat(), 0.0, false});
+            index[key_hash] = entries.begin();
+      }
+
+      static std::size_t hash_key(const arma::mat& ode_pars, const arma::uvec& key_inds) {
+
+            std::hash<double> hasher;
+            std::size_t key_hash = key_inds.n_elem;
+
+            for(arma::uword c = 0; c < key_inds.n_elem; ++c) {
+                  for(arma::uword r = 0; r < ode_pars.n_rows; ++r) {
+                        key_hash ^= hasher(ode_pars(r, key_inds[c])) + 0x9e3779b9 + (key_hash << 6) + (key_hash >> 2);
+                  }
+            }
+
+            return key_hash;
+      }
+
+      int capacity;
+      int path_hits;
+      int path_misses;
+      int loglik_hits;
+      int loglik_misses;
+      int size() const { return entries.size(); }
+
+private:
+      static bool key_matches(const arma::mat& key, const arma::mat& ode_pars, const arma::uvec& key_inds) {
+
+            if(key.n_rows != ode_pars.n_rows || key.n_cols != key_inds.n_elem) return false;
+
+            for(arma::uword c = 0; c < key_inds.n_elem; ++c) {
+                  for(arma::uword r = 0; r < ode_pars.n_rows; ++r) {
+                        if(key(r, c) != ode_pars(r, key_inds[c])) return false;
+                  }
+            }
+
+            return true;
+      }
+
+      std::list<ode_cache_entry> entries;
+      std::unordered_map<std::size_t, std::list<ode_cache_entry>::iterator> index;
+      double origin;
+};
+
+//' Create a bounded least recently used cache of ODE paths.
+//'
+//' @param capacity maximum number of paths to store
+//'
+//' @return external pointer to the cache
+//' @export
+// [[Rcpp::export]]
+SEXP create_ode_cache(int capacity) {
+      return Rcpp::XPtr<ode_path_cache>(new ode_path_cache(capacity), true);
+}
+
+//' Map parameters to the deterministic mean incidence increments, reusing a
+//' previously computed path if the parameters that determine it were seen
+//' before.
+//'
+//' @param ode_cache external pointer to the cache, see \code{create_ode_cache}.
+//'   If NULL, the path is always computed.
+//' @param key_inds C++ column indices of the parameter matrix that enter into
+//'   the rates, the initial volumes, or the forcings
+//' @inheritParams map_pars_2_ode
+//'
+//' @return TRUE if the path was retrieved from the cache, the path is copied
+//'   into pathmat in place
+//' @export
+// [[Rcpp::export]]
+bool map_pars_2_ode_cached(SEXP ode_cache,
+                           const arma::uvec& key_inds,
+                           arma::mat& pathmat,
+                           const arma::rowvec& ode_times,
+                           const Rcpp::NumericMatrix& ode_pars,
+                           const Rcpp::IntegerVector& ode_param_inds,
+                           const Rcpp::IntegerVector& ode_tcovar_inds,
+                           const int init_start,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::mat& stoich_matrix,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           double step_size,
+                           SEXP ode_pointer,
+                           SEXP set_pars_pointer) {
+
+      if(Rf_isNull(ode_cache)) {
+            map_pars_2_ode(pathmat, ode_times, ode_pars, ode_param_inds, ode_tcovar_inds, init_start,
+                           param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                           forcing_transfers, step_size, ode_pointer, set_pars_pointer);
+            return false;
+      }
+
+      Rcpp::XPtr<ode_path_cache> cache(ode_cache);
+      cache->set_origin(ode_times[0]);
+
+      const arma::mat pars(const_cast<double*>(ode_pars.begin()), ode_pars.nrow(), ode_pars.ncol(), false, true);
+      std::size_t key_hash = ode_path_cache::hash_key(pars, key_inds);
+
+      ode_cache_entry* entry = cache->find(pars, key_inds, key_hash);
+
+      if(entry) {
+            cache->path_hits += 1;
+            std::copy(entry->path.begin(), entry->path.end(), pathmat.begin());
+            return true;
+      }
+
+      // integrate the odes, only paths that were computed successfully are stored
+      cache->path_misses += 1;
+      map_pars_2_ode(pathmat, ode_times, ode_pars, ode_param_inds, ode_tcovar_inds, init_start,
+                     param_update_inds, stoich_matrix, forcing_inds, forcing_tcov_inds, forcings_out,
+                     forcing_transfers, step_size, ode_pointer, set_pars_pointer);
+
+      cache->insert(pars, key_inds, key_hash, pathmat);
+
+      return false;
+}
+
+//' Set the initial time of the ODE paths in a cache. The cache is cleared if
+//' the time differs from that of the stored paths, e.g., when a new t0 is
+//' accepted, since the paths and log likelihoods depend on it.
+//'
+//' @param ode_cache external pointer to the cache, see \code{create_ode_cache}.
+//'   If NULL, nothing is done.
+//' @param origin initial time of the ODEs
+//' @export
+// [[Rcpp::export]]
+void ode_cache_set_origin(SEXP ode_cache, double origin) {
+
+      if(Rf_isNull(ode_cache)) return;
+
+      Rcpp::XPtr<ode_path_cache> cache(ode_cache);
+      cache->set_origin(origin);
+}
+
+//' Retrieve the cached data log likelihood for a parameter matrix.
+//'
+//' @param ode_cache external pointer to the cache, see \code{create_ode_cache}
+//' @param ode_pars numeric matrix of parameters, constants, and time-varying
+//'   covariates at each of the ode_times
+//' @param key_inds C++ column indices of the parameter matrix that determine
+//'   the path
+//'
+//' @return data log likelihood if it was stored for exactly this parameter
+//'   matrix, NA otherwise
+//' @export
+// [[Rcpp::export]]
+double ode_cache_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds) {
+
+      if(Rf_isNull(ode_cache)) return NA_REAL;
+
+      Rcpp::XPtr<ode_path_cache> cache(ode_cache);
+      ode_cache_entry* entry = cache->find(ode_pars, key_inds, ode_path_cache::hash_key(ode_pars, key_inds));
+
+      if(entry && entry->has_loglik && arma::approx_equal(entry->loglik_pars, ode_pars, "absdiff", 0.0)) {
+            cache->loglik_hits += 1;
+            return entry->loglik;
+      }
+
+      cache->loglik_misses += 1;
+      return NA_REAL;
+}
+
+//' Store the data log likelihood for a parameter matrix whose path is cached.
+//'
+//' @param ode_cache external pointer to the cache, see \code{create_ode_cache}
+//' @param ode_pars numeric matrix of parameters, constants, and time-varying
+//'   covariates at each of the ode_times
+//' @param key_inds C++ column indices of the parameter matrix that determine
+//'   the path
+//' @param loglik data log likelihood
+//' @export
+// [[Rcpp::export]]
+void ode_cache_set_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds, double loglik) {
+
+      if(Rf_isNull(ode_cache)) return;
+
+      Rcpp::XPtr<ode_path_cache> cache(ode_cache);
+      ode_cache_entry* entry = cache->find(ode_pars, key_inds, ode_path_cache::hash_key(ode_pars, key_inds));
+
+      if(entry) {
+            entry->loglik_pars = ode_pars;
+            entry->loglik      = loglik;
+            entry->has_loglik  = true;
+      }
+}
+
+//' Report the number of hits and misses of an ODE path cache.
+//'
+//' @param ode_cache external pointer to the cache, see \code{create_ode_cache}
+//'
+//' @return list with the numbers of path and log likelihood hits and misses,
+//'   and the size and capacity of the cache
+//' @export
+// [[Rcpp::export]]
+Rcpp::List ode_cache_stats(SEXP ode_cache) {
+
+      Rcpp::XPtr<ode_path_cache> cache(ode_cache);
+
+      return Rcpp::List::create(Rcpp::Named("path_hits")     = cache->path_hits,
+                                Rcpp::Named("path_misses")   = cache->path_misses,
+                                Rcpp::Named("loglik_hits")   = cache->loglik_hits,
+                                Rcpp::Named("loglik_misses") = cache->loglik_misses,
+                                Rcpp::Named("size")          = cache->size(),
+                                Rcpp::Named("capacity")      = cache->capacity);
+}
@@ -0,0 +1,361 @@
+#ifndef stemr_path_integrators_h
+#define stemr_path_integrators_h
+
+#include "stemr_types.h"
+#include "stemr_utils.h"
+#include "forcing_operator.h"
+#include <stdexcept>
+#include <vector>
+
+// the ODE and LNA paths are mapped by the templates below, which integrate over each interval
+// through an integrator with a state buffer, state(), a parameter setter, set_params(), and
+// integrate(t_L, t_R). errors are thrown as std::runtime_error.
+
+// integrates through the global objects of the compiled odeintr code via the external pointers.
+// the parameters are those held in param_vec, which the setter copies into the odeintr namespace.
+class odeintr_integrator {
+
+public:
+      odeintr_integrator(Rcpp::NumericVector& param_vec, int n_odes, double step_size,
+                         SEXP ode_pointer, SEXP set_pars_pointer) :
+            param_vec(param_vec), state_vec(n_odes), step_size(step_size),
+            ode_pointer(ode_pointer), set_pars_pointer(set_pars_pointer) {}
+
+      double* state() { return state_vec.begin(); }
+
+      void set_params(const double*) { CALL_SET_ODE_PARAMS(param_vec, set_pars_pointer); }
+
+      void integrate(double t_L, double t_R) {
+            CALL_INTEGRATE_STEM_ODE(state_vec, t_L, t_R, step_size, ode_pointer);
+      }
+
+private:
+      Rcpp::NumericVector& param_vec;
+      Rcpp::NumericVector state_vec;
+      double step_size;
+      SEXP ode_pointer;
+      SEXP set_pars_pointer;
+};
+
+// integrates through the native entry point of the compiled code, which takes the parameters
+// as an argument and keeps the integration state on its stack. paths can therefore be mapped
+// concurrently, does not call into R.
+class native_integrator {
+
+public:
+      native_integrator(ode_native_ptr integrate_fcn, int n_odes, double step_size) :
+            integrate_fcn(integrate_fcn), state_vec(n_odes), step_size(step_size), params(nullptr) {}
+
+      double* state() { return state_vec.data(); }
+
+      void set_params(const double* p) { params = p; }
+
+      void integrate(double t_L, double t_R) {
+            integrate_fcn(state_vec.data(), params, t_L, t_R, step_size);
+      }
+
+private:
+      ode_native_ptr integrate_fcn;
+      std::vector<double> state_vec;
+      double step_size;
+      const double* params;
+};
+
+// map parameters to the deterministic mean incidence increments, see map_pars_2_ode.
+// current_params is a buffer for the parameter vector at each time, it is passed to the integrator.
+template <typename Integrator>
+void map_pars_2_ode_path(arma::mat& pathmat,
+                         const arma::rowvec& ode_times,
+                         const arma::mat& ode_pars,
+                         double* current_params,
+                         const int n_tcovar,
+                         const int init_start,
+                         const Rcpp::LogicalVector& param_update_inds,
+                         const arma::mat& stoich_matrix,
+                         const Rcpp::LogicalVector& forcing_inds,
+                         const arma::uvec& forcing_tcov_inds,
+                         const arma::mat& forcings_out,
+                         const arma::cube& forcing_transfers,
+                         Integrator& integrator) {
+
+        // get the dimensions of various objects
+        int n_events   = stoich_matrix.n_cols;     // number of transition events, e.g., S2I, I2R
+        int n_comps    = stoich_matrix.n_rows;     // number of model compartments (all strata)
+        int n_times    = ode_times.n_elem;         // number of times at which the ODEs must be evaluated
+        int n_pars     = ode_pars.n_cols;          // number of parameters, constants, and covariates
+        int n_forcings = forcing_tcov_inds.n_elem; // number of forcings
+
+        // for use with forcings
+        double forcing_flow = 0;
+        forcing_operator forcing_op(forcings_out, forcing_transfers);
+
+        // initialize the objects used in each time interval
+        double t_L = 0;
+        double t_R = 0;
+        for(int c = 0; c < n_pars; ++c) current_params[c] = ode_pars(0, c);
+        integrator.set_params(current_params);
+
+        // initial state vector - copy elements from the current parameter vector
+        arma::vec init_volumes(current_params + init_start, n_comps);
+
+        // the ODE state vector, which holds the increments over an interval
+        arma::vec ode_state(integrator.state(), n_events, false, true);
+
+        // apply forcings if called for - applied after censusing at the first time
+        if(forcing_inds[0]) {
+
+              // distribute the forcings proportionally to the compartment counts in the applicable states
+              for(int j=0; j < n_forcings; ++j) {
+
+                    forcing_flow       = ode_pars(0, forcing_tcov_inds[j]);
+                    forcing_op.apply(init_volumes.memptr(), j, forcing_flow);
+              }
+        }
+
+        // iterate over the time sequence, solving the ODEs over each interval
+        for(int j=0; j < (n_times-1); ++j) {
+
+                // set the times of the interval endpoints
+                t_L = ode_times[j];
+                t_R = ode_times[j+1];
+
+                // Reset the ODE state vector and integrate the ODEs over the next interval
+                ode_state.zeros();
+                integrator.integrate(t_L, t_R);
+
+                // compute the compartment volumes
+                init_volumes += stoich_matrix * ode_state;
+
+                // Save the increment and volumes
+                pathmat(j+1, arma::span(1, n_events)) = ode_state.t();
+
+                // apply forcings if called for - applied after censusing the path
+                if(forcing_inds[j+1]) {
+
+                      // distribute the forcings proportionally to the compartment counts in the applicable states
+                      for(int s=0; s < n_forcings; ++s) {
+
+                            forcing_flow       = ode_pars(j+1, forcing_tcov_inds[s]);
+                            forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
+                      }
+                }
+
+                // ensure the initial volumes are non-negative
+                if(any(init_volumes < 0)) {
+                        throw std::runtime_error("Negative compartment volumes.");
+                }
+
+                // update the parameters if they need to be updated
+                if(param_update_inds[j+1]) {
+
+                      // time-varying covariates and parameters
+                      for(int c = n_pars - n_tcovar; c < n_pars; ++c) current_params[c] = ode_pars(j+1, c);
+                }
+
+                // copy the compartment volumes to the current parameters
+                std::copy(init_volumes.begin(), init_volumes.end(), current_params + init_start);
+
+                // set the ODE parameters
+                integrator.set_params(current_params);
+        }
+}
+
+// map N(0,1) draws to an LNA path, censusing it in the same pass if census_inds is not empty,
+// see map_draws_2_lna_census. lna_param_vec is a buffer for the parameter vector at each time,
+// it is passed to the integrator.
+template <typename Integrator>
+void map_draws_2_lna_path(arma::mat& pathmat,
+                          const arma::mat& draws,
+                          const arma::rowvec& lna_times,
+                          const arma::mat& lna_pars,
+                          double* lna_param_vec,
+                          const int n_tcovar,
+                          const int init_start,
+                          const Rcpp::LogicalVector& param_update_inds,
+                          const arma::mat& stoich_matrix,
+                          const Rcpp::LogicalVector& forcing_inds,
+                          const arma::uvec& forcing_tcov_inds,
+                          const arma::mat& forcings_out,
+                          const arma::cube& forcing_transfers,
+                          arma::vec& svd_d,
+                          arma::mat& svd_U,
+                          arma::mat& svd_V,
+                          arma::mat& census_path,
+                          const arma::uvec& census_inds,
+                          const arma::uvec& lna_event_inds,
+                          const arma::mat& flow_matrix_lna,
+                          bool do_prevalence,
+                          const arma::rowvec& init_state,
+                          bool store_path,
+                          Integrator& integrator) {
+
+        // get the dimensions of various objects
+        int n_events   = stoich_matrix.n_cols;     // number of transition events, e.g., S2I, I2R
+        int n_comps    = stoich_matrix.n_rows;     // number of model compartments (all strata)
+        int n_times    = lna_times.n_elem;         // number of times at which the LNA must be evaluated
+        int n_pars     = lna_pars.n_cols;          // number of parameters, constants, and covariates
+        int n_forcings = forcing_tcov_inds.n_elem; // number of forcings
+
+        // for use with forcings
+        double forcing_flow = 0;
+        forcing_operator forcing_op(forcings_out, forcing_transfers);
+
+        // census objects, the census state and forcings are handled as in census_lna
+        int n_census_times  = census_inds.n_elem;
+        int n_census_events = lna_event_inds.n_elem;
+        int n_census_comps  = flow_matrix_lna.n_cols;
+        int n_rates         = flow_matrix_lna.n_rows;
+        int incid_start     = n_census_comps + 1;
+        int census_k        = 1; // census interval closed by the next increment
+
+        arma::rowvec census_state(init_state);
+        arma::rowvec increment(n_rates, arma::fill::zeros);
+
+        if(n_census_times > 1) {
+              census_path(arma::span(0, n_census_times-2), arma::span(incid_start, incid_start + n_census_events - 1)).zeros();
+        }
+
+        // initialize the objects used in each time interval
+        double t_L = 0;
+        double t_R = 0;
+
+        // vector of parameters, initial compartment columes, constants, and time-varying covariates
+        for(int c = 0; c < n_pars; ++c) lna_param_vec[c] = lna_pars(0, c);
+        integrator.set_params(lna_param_vec);
+
+        // initial state vector - copy elements from the current parameter vector
+        arma::vec init_volumes(lna_param_vec + init_start, n_comps);
+
+        // initialize the LNA objects, the state of the LNA ODEs holds the drift and the diffusion
+        bool good_svd = true;
+
+        const arma::vec lna_drift(integrator.state(), n_events, false, true);                           // incidence mean vector (log scale)
+        arma::mat lna_diffusion(integrator.state() + n_events, n_events, n_events, false, true); // diffusion matrix
+
+        arma::vec log_lna(n_events, arma::fill::zeros);  // LNA increment, log scale
+        arma::vec nat_lna(n_events, arma::fill::zeros);  // LNA increment, natural scale
+
+        // apply forcings if called for - applied after censusing at the first time
+        if(forcing_inds[0]) {
+
+              // distribute the forcings proportionally to the compartment counts in the applicable states
+              for(int j=0; j < n_forcings; ++j) {
+
+                    forcing_flow       = lna_pars(0, forcing_tcov_inds[j]);
+                    forcing_op.apply(init_volumes.memptr(), j, forcing_flow);
+              }
+        }
+
+        // iterate over the time sequence, solving the LNA over each interval
+        for(int j=0; j < (n_times-1); ++j) {
+
+                // set the times of the interval endpoints
+                t_L = lna_times[j];
+                t_R = lna_times[j+1];
+
+                // Reset the LNA state vector and integrate the LNA ODEs over the next interval to 0
+                std::fill(integrator.state(), integrator.state() + n_events + n_events*n_events, 0.0);
+                integrator.integrate(t_L, t_R);
+
+                // ensure symmetry of the diffusion matrix
+                lna_diffusion = arma::symmatu(lna_diffusion);
+
+                // map the stochastic perturbation to the LNA path on its natural scale
+                if(lna_drift.has_nan() || lna_diffusion.has_nan()) {
+                        throw std::runtime_error("Integration failed.");
+                }
+
+                good_svd = arma::svd(svd_U, svd_d, svd_V, lna_diffusion); // compute the SVD
+
+                if(!good_svd) {
+                        throw std::runtime_error("SVD failed.");
+                }
+
+                svd_d.elem(arma::find(svd_d < 0)).zeros();          // zero out negative sing. vals
+                svd_V.each_row() %= arma::sqrt(svd_d).t();          // multiply rows of V by sqrt(d)
+                svd_U *= svd_V.t();                                 // complete svd_sqrt
+                svd_U.elem(arma::find(lna_diffusion == 0)).zeros(); // zero out numerical errors
+
+                log_lna = lna_drift + svd_U * draws.col(j);         // map the LNA draws
+
+                // compute the LNA increment
+                for(int e = 0; e < n_events; ++e) nat_lna[e] = std::expm1(log_lna[e]);
+
+                // save the LNA increment
+                if(store_path) pathmat(j+1, arma::span(1, n_events)) = nat_lna.t();
+
+                // accumulate the increment into its census interval
+                if(census_k < n_census_times && j+1 > static_cast<int>(census_inds[census_k-1])) {
+
+                      for(int e = 0; e < n_census_events; ++e) {
+                            census_path(census_k-1, incid_start + e) += nat_lna[lna_event_inds[e] - 1];
+                      }
+
+                      if(do_prevalence) increment += nat_lna.head(n_rates).t();
+
+                      // close the census interval
+                      if(j+1 == static_cast<int>(census_inds[census_k])) {
+
+                            if(do_prevalence && census_k < n_census_times-1) {
+
+                                  // save the state and apply forcings - applied after censusing the path
+                                  census_state += increment * flow_matrix_lna;
+                                  census_path(census_k-1, arma::span(1, n_census_comps)) = census_state;
+                                  increment.zeros();
+
+                                  if(forcing_inds[census_k]) {
+                                        for(int s=0; s < n_forcings; ++s) {
+                                              forcing_flow     = lna_pars(census_k, forcing_tcov_inds[s]);
+                                              forcing_op.apply(census_state.memptr(), s, forcing_flow);
+                                        }
+                                  }
+                            }
+
+                            ++census_k;
+                      }
+                }
+
+                // update the initial volumes
+                init_volumes += stoich_matrix * nat_lna;
+
+                // if any increments or volumes are negative, throw an error
+                if(any(nat_lna < 0)) {
+                        throw std::runtime_error("Negative increment.");
+                }
+
+                if(any(init_volumes < 0)) {
+                        throw std::runtime_error("Negative compartment volumes.");
+                }
+
+                // apply forcings if called for - applied after censusing the path
+                if(forcing_inds[j+1]) {
+
+                      // distribute the forcings proportionally to the compartment counts in the applicable states
+                      for(int s=0; s < n_forcings; ++s) {
+
+                            forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
+                            forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
+                      }
+
+                      // throw errors for negative negative volumes
+                      if(any(init_volumes < 0)) {
+                            throw std::runtime_error("Negative compartment volumes.");
+                      }
+                }
+
+                // update the parameters if they need to be updated
+                if(param_update_inds[j+1]) {
+
+                      // time-varying covariates and parameters
+                      for(int c = n_pars - n_tcovar; c < n_pars; ++c) lna_param_vec[c] = lna_pars(j+1, c);
+                }
+
+                // copy the new initial volumes into the vector of parameters
+                std::copy(init_volumes.begin(), init_volumes.end(), lna_param_vec + init_start);
+
+                // set the lna parameters
+                integrator.set_params(lna_param_vec);
+        }
+}
+
+#endif
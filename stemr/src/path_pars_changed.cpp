@@ -0,0 +1,32 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include <RcppArmadillo.h>
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Check whether any of the parameters, constants, or time-varying covariates
+//' that determine the LNA or ODE path have changed.
+//'
+//' @param pars matrix of lna/ode parameters, constants, and time-varying covars
+//' @param pars_ref matrix with the reference values of the columns of the
+//'   parameter matrix that determine the path, in the order given by col_inds
+//' @param col_inds C++ column indices of the parameter matrix that enter into
+//'   the rates, the initial volumes, or the forcings
+//'
+//' @return TRUE if the path needs to be recomputed, FALSE otherwise
+//' @export
+// [[Rcpp::export]]
+bool path_pars_changed(const arma::mat& pars, const arma::mat& pars_ref, const arma::uvec& col_inds) {
+
+      int n_rows = pars.n_rows;
+      int n_cols = col_inds.n_elem;
+
+      // columns are contiguous in memory, stop at the first difference
+      for(int c = 0; c < n_cols; ++c) {
+            for(int r = 0; r < n_rows; ++r) {
+                  if(pars(r, col_inds[c]) != pars_ref(r, c)) return true;
+            }
+      }
+
+      return false;
+}
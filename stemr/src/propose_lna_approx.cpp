@@ -1,6 +1,7 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include "stemr_types.h"
 #include "stemr_utils.h"
+#include "forcing_operator.h"
 
 using namespace Rcpp;
 using namespace arma;
@@ -65,7 +66,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
         
         // for use with forcings
         double forcing_flow = 0;
-        arma::vec forcing_distvec(n_comps, arma::fill::zeros);
+        forcing_operator forcing_op(forcings_out, forcing_transfers);
 
         // initialize the LNA objects - the vector for storing the current state
         Rcpp::NumericVector lna_state_vec(n_odes);   // vector to store the results of the ODEs
@@ -108,9 +109,9 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
               for(int s=0; s < n_forcings; ++s) {
                     
                     forcing_flow       = lna_pars(0, forcing_tcov_inds[s]);
-                    forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                    init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                    init_volumes_prop += forcing_transfers.slice(s) * forcing_distvec;
+                    forcing_op.distribute(init_volumes.memptr(), s, forcing_flow);
+                    forcing_op.transfer(init_volumes.memptr(), s);
+                    forcing_op.transfer(init_volumes_prop.memptr(), s);
               }
         }
         
@@ -232,8 +233,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                     for(int s=0; s < n_forcings; ++s) {
                           
                           forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                          forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                          init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                          forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                     }
                     
                     // throw errors for negative increments or negative volumes
@@ -285,9 +285,9 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                     for(int s=0; s < n_forcings; ++s) {
                           
                           forcing_flow       = lna_pars(0, forcing_tcov_inds[s]);
-                          forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                          init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                          init_volumes_prop += forcing_transfers.slice(s) * forcing_distvec;
+                          forcing_op.distribute(init_volumes.memptr(), s, forcing_flow);
+                          forcing_op.transfer(init_volumes.memptr(), s);
+                          forcing_op.transfer(init_volumes_prop.memptr(), s);
                     }
               }
               
@@ -382,8 +382,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                           for(int s=0; s < n_forcings; ++s) {
                                 
                                 forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                                forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                                forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                           }
                           
                           // throw errors for negative increments or negative volumes
@@ -427,9 +426,9 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                           for(int s=0; s < n_forcings; ++s) {
                                 
                                 forcing_flow       = lna_pars(0, forcing_tcov_inds[s]);
-                                forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                                init_volumes_prop += forcing_transfers.slice(s) * forcing_distvec;
+                                forcing_op.distribute(init_volumes.memptr(), s, forcing_flow);
+                                forcing_op.transfer(init_volumes.memptr(), s);
+                                forcing_op.transfer(init_volumes_prop.memptr(), s);
                           }
                     }
                     
@@ -524,8 +523,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                                 for(int s=0; s < n_forcings; ++s) {
                                       
                                       forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                                      forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                      init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                                      forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                                 }
                                 
                                 // throw errors for negative increments or negative volumes
@@ -577,9 +575,9 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                     for(int s=0; s < n_forcings; ++s) {
                           
                           forcing_flow       = lna_pars(0, forcing_tcov_inds[s]);
-                          forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                          init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                          init_volumes_prop += forcing_transfers.slice(s) * forcing_distvec;
+                          forcing_op.distribute(init_volumes.memptr(), s, forcing_flow);
+                          forcing_op.transfer(init_volumes.memptr(), s);
+                          forcing_op.transfer(init_volumes_prop.memptr(), s);
                     }
               }
               
@@ -681,8 +679,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                           for(int s=0; s < n_forcings; ++s) {
                                 
                                 forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                                forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                                forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                           }
                           
                           // throw errors for negative increments or negative volumes
@@ -726,9 +723,9 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                           for(int s=0; s < n_forcings; ++s) {
                                 
                                 forcing_flow       = lna_pars(0, forcing_tcov_inds[s]);
-                                forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
-                                init_volumes_prop += forcing_transfers.slice(s) * forcing_distvec;
+                                forcing_op.distribute(init_volumes.memptr(), s, forcing_flow);
+                                forcing_op.transfer(init_volumes.memptr(), s);
+                                forcing_op.transfer(init_volumes_prop.memptr(), s);
                           }
                     }
                     
@@ -829,8 +826,7 @@ Rcpp::List propose_lna_approx(const arma::rowvec& lna_times,
                                 for(int s=0; s < n_forcings; ++s) {
                                       
                                       forcing_flow       = lna_pars(j+1, forcing_tcov_inds[s]);
-                                      forcing_distvec    = forcing_flow * normalise(forcings_out.col(s) % init_volumes, 1);
-                                      init_volumes      += forcing_transfers.slice(s) * forcing_distvec;
+                                      forcing_op.apply(init_volumes.memptr(), s, forcing_flow);
                                 }
                                 
                                 // throw errors for negative increments or negative volumes
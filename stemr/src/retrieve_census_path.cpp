@@ -1,6 +1,7 @@
 // [[Rcpp::depends(RcppArmadillo)]]
 #include "stemr_types.h"
 #include "stemr_utils.h"
+#include "census_engine.h"
 
 using namespace arma;
 using namespace Rcpp;
@@ -18,19 +19,15 @@ using namespace Rcpp;
 // [[Rcpp::export]]
 void retrieve_census_path(arma::mat& censusmat, Rcpp::NumericMatrix& path, Rcpp::NumericVector& census_times, Rcpp::IntegerVector& census_columns) {
 
-        // get dimensions
-        int n_census_times = census_times.size();
-        int n_comps = census_columns.size();
-        Rcpp::IntegerVector path_dims = path.attr("dim");
-
         // get path matrix pointers
-        arma::mat path_mat(path.begin(), path_dims[0], path_dims[1], false);
+        arma::mat path_mat(path.begin(), path.nrow(), path.ncol(), false);
 
-        // get vector of times in the path matrix and the census time indices
-        Rcpp::NumericVector timevec = path(_,0);
-        Rcpp::IntegerVector census_inds(n_census_times);
-        census_inds = find_interval(census_times, timevec, true, true) - 1; // rightmost_closed = true, all.inside = true
+        // locate the census times in the path by a linear merge
+        arma::uvec census_inds;
+        merge_census_inds(census_inds, path_mat.colptr(0), path_mat.n_rows,
+                          census_times.begin(), census_times.size(), true);
 
         // fill out the census matrix
-        censusmat.cols(1, n_comps) = path_mat.submat(Rcpp::as<arma::uvec>(census_inds), Rcpp::as<arma::uvec>(census_columns));
+        fill_census(censusmat, path_mat, census_inds, census_columns,
+                    std::vector<bool>(census_columns.size() + 1, false));
 }
\ No newline at end of file
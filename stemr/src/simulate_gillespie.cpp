@@ -2,6 +2,7 @@
 #include "stemr_types.h"
 #include "stemr_utils.h"
 #include <RcppArmadilloExtensions/sample.h>
+#include "forcing_operator.h"
 
 using namespace arma;
 using namespace Rcpp;
@@ -58,7 +59,7 @@ arma::mat simulate_gillespie(const arma::mat& flow,
       
       // for use with forcings
       double forcing_flow = 0;
-      arma::vec forcing_distvec(init_dims[1]-2, arma::fill::zeros);
+      forcing_operator forcing_op(forcings_out, forcing_transfers);
       
       // initialize bookkeeping matrix
       arma::mat path(init_dims[0], init_dims[1]);
@@ -90,8 +91,7 @@ arma::mat simulate_gillespie(const arma::mat& flow,
                   
                   // distribute the forcings proportionally to the compartment counts in the applicable states
                   forcing_flow = tcovar(tcov_ind, forcing_tcov_inds[j]);
-                  forcing_distvec = arma::round(forcing_flow * normalise(forcings_out.col(j) % state.t(), 1));
-                  state += (forcing_transfers.slice(j) * forcing_distvec).t();
+                  forcing_op.apply(state.memptr(), j, forcing_flow, true);
             }
       }
       
@@ -145,8 +145,7 @@ arma::mat simulate_gillespie(const arma::mat& flow,
                                     
                                     // distribute the forcings proportionally to the compartment counts in the applicable states
                                     forcing_flow = tcovar(tcov_ind, forcing_tcov_inds[j]);
-                                    forcing_distvec = arma::round(forcing_flow * normalise(forcings_out.col(j) % state.t(), 1));
-                                    state += (forcing_transfers.slice(j) * forcing_distvec).t();
+                                    forcing_op.apply(state.memptr(), j, forcing_flow, true);
                               }
                               
                               // throw errors for negative volumes
@@ -8,8 +8,8 @@ using namespace Rcpp;
 //' model.
 //'
 //' @param censusmat matrix of compartment counts at observation times
-//' @param measproc_indmat logical matrix for which measure variables are
-//'        observed at which times
+//' @param obs_layout list with the compressed observation layout, see
+//'        \code{build_obs_layout}
 //' @param parameters numeric vector of model parameters
 //' @param constants numeric vector of constants
 //' @param tcovar numeric matrix of time-varying covariate values at observation
@@ -19,20 +19,29 @@ using namespace Rcpp;
 //' @return matrix with a simulated dataset from a stochastic epidemic model.
 //' @export
 // [[Rcpp::export]]
-Rcpp::NumericMatrix simulate_r_measure(Rcpp::NumericMatrix& censusmat, Rcpp::LogicalMatrix& measproc_indmat, Rcpp::NumericVector& parameters, Rcpp::NumericVector& constants, Rcpp::NumericMatrix& tcovar, SEXP r_measure_ptr) {
+Rcpp::NumericMatrix simulate_r_measure(Rcpp::NumericMatrix& censusmat, const Rcpp::List& obs_layout, Rcpp::NumericVector& parameters, Rcpp::NumericVector& constants, Rcpp::NumericMatrix& tcovar, SEXP r_measure_ptr) {
 
-        // Get object dimensions
-        Rcpp::IntegerVector obsmat_dims = measproc_indmat.attr("dim");
+        // variables observed at each observation time, in compressed row format
+        Rcpp::IntegerVector row_ptr  = obs_layout["row_ptr"];
+        Rcpp::IntegerVector col_inds = obs_layout["col_inds"];
+        Rcpp::IntegerVector obs_rows = obs_layout["obs_rows"];
+        Rcpp::List var_inds          = obs_layout["var_inds"];
+        Rcpp::LogicalVector emit_inds(var_inds.size());
 
         // create observation matrix
-        Rcpp::NumericMatrix obsmat(obsmat_dims[0], obsmat_dims[1] + 1);
+        Rcpp::NumericMatrix obsmat(row_ptr.size() - 1, var_inds.size() + 1);
         obsmat(_, 0) = censusmat(_, 0); // copy the observation times
 
-        // simulate the dataset
-        for(int j=0; j < obsmat_dims[0]; ++j) {
-              
+        // simulate the dataset at times when something is observed
+        for(int i=0; i < obs_rows.size(); ++i) {
+
+                int j = obs_rows[i];
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = true;
+
                 // obsmat, emit_inds, record_ind, state, parameters, constants, tcovar, ptr
-                CALL_R_MEASURE(obsmat, measproc_indmat(j, _), j, censusmat.row(j), parameters, constants, tcovar(j, _), r_measure_ptr);
+                CALL_R_MEASURE(obsmat, emit_inds, j, censusmat.row(j), parameters, constants, tcovar(j, _), r_measure_ptr);
+
+                for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) emit_inds[col_inds[k]] = false;
         }
 
         return obsmat;
@@ -0,0 +1,96 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "stemr_types.h"
+#include "stemr_parallel.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Simulate datasets from the measurement process of a stochastic epidemic
+//' model for a stack of census matrices, in parallel.
+//'
+//' @param censusmats cube of compartment counts at observation times, one
+//'        slice per dataset, or a single slice shared by all datasets
+//' @param obs_layout list with the compressed observation layout, see
+//'        \code{build_obs_layout}
+//' @param parameters matrix of model parameters, one column per dataset
+//' @param constants numeric vector of constants
+//' @param tcovars cube of time-varying covariate values at observation times,
+//'        one slice per dataset, or a single slice shared by all datasets
+//' @param r_meas_native_ptr external pointer to the thread safe measurement
+//'        process simulation fcn
+//' @param seed seed for the random number engines, dataset k is simulated from
+//'        its own engine seeded with (seed, k), so the datasets do not depend
+//'        on the number of threads
+//' @param n_threads number of threads
+//'
+//' @return cube with one simulated dataset per slice.
+//' @export
+// [[Rcpp::export]]
+arma::cube simulate_r_measure_batch(const arma::cube& censusmats,
+                                    const Rcpp::List& obs_layout,
+                                    const arma::mat& parameters,
+                                    const arma::vec& constants,
+                                    const arma::cube& tcovars,
+                                    SEXP r_meas_native_ptr,
+                                    int seed,
+                                    int n_threads = 1) {
+
+      // variables observed at each observation time, in compressed row format
+      // copied out of the R objects so that the workers do not touch R memory management
+      std::vector<int> row_ptr  = Rcpp::as<std::vector<int>>(obs_layout["row_ptr"]);
+      std::vector<int> col_inds = Rcpp::as<std::vector<int>>(obs_layout["col_inds"]);
+      std::vector<int> obs_rows = Rcpp::as<std::vector<int>>(obs_layout["obs_rows"]);
+      int n_vars                = Rcpp::as<Rcpp::List>(obs_layout["var_inds"]).size();
+
+      // get dimensions
+      int n_obstimes = row_ptr.size() - 1;
+      int n_sets     = parameters.n_cols;
+      int n_comps    = censusmats.n_cols;
+      int n_tcovar   = tcovars.n_cols;
+
+      if((censusmats.n_slices != 1 && int(censusmats.n_slices) != n_sets) ||
+         (tcovars.n_slices != 1 && int(tcovars.n_slices) != n_sets)) {
+            Rcpp::stop("The census and covariate stacks must have one slice or one slice per parameter set.");
+      }
+
+      Rcpp::XPtr<r_measure_native_ptr> xpfun(r_meas_native_ptr);
+      r_measure_native_ptr r_measure = *xpfun;
+
+      // observation cube, unobserved entries are left as zero
+      arma::cube obscube(n_obstimes, n_vars + 1, n_sets, arma::fill::zeros);
+
+      parallel_for(n_sets, n_threads, [&](int k) {
+
+            const arma::mat& censusmat = censusmats.slice(censusmats.n_slices == 1 ? 0 : k);
+            const arma::mat& tcovar    = tcovars.slice(tcovars.n_slices == 1 ? 0 : k);
+            arma::mat& obsmat          = obscube.slice(k);
+
+            // the engine for dataset k is determined by the seed and the dataset index
+            std::seed_seq seeds{static_cast<unsigned int>(seed), static_cast<unsigned int>(k)};
+            std::mt19937_64 rng(seeds);
+
+            // rows of the slices are strided, copy them into contiguous buffers
+            std::vector<double> state(n_comps), tcov(n_tcovar), obs(n_vars + 1);
+            std::vector<int> emit_inds(n_vars, 0);
+
+            obsmat.col(0) = censusmat.col(0); // copy the observation times
+
+            for(int j : obs_rows) {
+
+                  for(int c = 0; c < n_comps; ++c)  state[c] = censusmat(j, c);
+                  for(int c = 0; c < n_tcovar; ++c) tcov[c]  = tcovar(j, c);
+                  for(int k_obs = row_ptr[j]; k_obs < row_ptr[j+1]; ++k_obs) emit_inds[col_inds[k_obs]] = 1;
+
+                  std::fill(obs.begin(), obs.end(), 0.0);
+                  r_measure(obs.data(), emit_inds.data(), state.data(), parameters.colptr(k),
+                            constants.memptr(), tcov.data(), rng);
+
+                  for(int k_obs = row_ptr[j]; k_obs < row_ptr[j+1]; ++k_obs) {
+                        obsmat(j, col_inds[k_obs] + 1) = obs[col_inds[k_obs] + 1];
+                        emit_inds[col_inds[k_obs]]     = 0;
+                  }
+            }
+      });
+
+      return obscube;
+}
@@ -0,0 +1,181 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "slice_target.h"
+#include <limits>
+#include <vector>
+
+using namespace Rcpp;
+using namespace arma;
+
+// the batched version of the update below. the bracket is stepped out at both ends at once, the
+// endpoints are processed in the order of the sequential update so the bracket and the number of
+// expansions are the same. the proposals of each batch are drawn uniformly from the bracket at the
+// start of the batch and processed in order, proposals that fall outside the bracket after it
+// was shrunk by an earlier proposal of the batch are skipped. a skipped proposal is a draw from
+// the uniform on the shrunk bracket that was rejected, so the accepted point has the same
+// distribution as in the sequential update.
+static slice_line_counts slice_line_update_batch(slice_target& target,
+                                                 double threshold,
+                                                 const arma::rowvec& direction,
+                                                 double width,
+                                                 double min_width) {
+
+      slice_line_counts counts = {false, 0, 0};
+      arma::rowvec origin      = target.params_est();
+      int batch_size           = target.batch_size();
+
+      std::vector<arma::rowvec> points;
+      std::vector<double> steps;
+      arma::vec logpost;
+
+      // construct the approximate bracket
+      double lower = -width * R::runif(0.0, 1.0);
+      double upper = lower + width;
+
+      // step out the bracket, the next endpoints are computed as in the sequential update
+      bool lower_open = true, upper_open = true;
+      double next_lower = lower, next_upper = upper;
+
+      while(lower_open || upper_open) {
+
+            int n_lower = !lower_open ? 0 : (upper_open ? (batch_size + 1) / 2 : batch_size);
+            int n_upper = !upper_open ? 0 : batch_size - n_lower;
+
+            points.clear();
+            steps.clear();
+
+            double step = next_lower;
+            for(int k = 0; k < n_lower; ++k, step -= width) steps.push_back(step);
+
+            step = next_upper;
+            for(int k = 0; k < n_upper; ++k, step += width) steps.push_back(step);
+
+            for(double s : steps) points.push_back(origin + s * direction);
+            target.log_posterior_batch(points, logpost);
+
+            for(int k = 0; k < n_lower && lower_open; ++k) {
+                  if(threshold < logpost[k]) {
+                        lower = steps[k] - width;
+                        counts.n_expansions += 1;
+                  } else {
+                        lower_open = false;
+                  }
+            }
+
+            for(int k = n_lower; k < n_lower + n_upper && upper_open; ++k) {
+                  if(threshold < logpost[k]) {
+                        upper = steps[k] + width;
+                        counts.n_expansions += 1;
+                  } else {
+                        upper_open = false;
+                  }
+            }
+
+            next_lower = lower;
+            next_upper = upper;
+      }
+
+      // sample from the bracket
+      int accepted_ind = -1;
+
+      while((upper - lower) > min_width && accepted_ind < 0) {
+
+            points.clear();
+            steps.clear();
+
+            for(int k = 0; k < batch_size; ++k) steps.push_back(R::runif(lower, upper));
+            for(double s : steps) points.push_back(origin + s * direction);
+            target.log_posterior_batch(points, logpost);
+
+            for(int k = 0; k < batch_size; ++k) {
+
+                  if((upper - lower) <= min_width) break;
+                  if(steps[k] <= lower || steps[k] >= upper) continue;
+
+                  if(!(logpost[k] < threshold)) {
+                        accepted_ind = k;
+                        break;
+                  }
+
+                  if(steps[k] < 0) {
+                        lower = steps[k];
+                  } else {
+                        upper = steps[k];
+                  }
+
+                  counts.n_contractions += 1;
+            }
+      }
+
+      counts.accepted = (upper - lower) > min_width;
+
+      if(counts.accepted) {
+            target.accept_batch(accepted_ind);
+      } else {
+            target.restore();
+      }
+
+      return counts;
+}
+
+// step out a bracket of the given width around the current parameters, then sample
+// uniformly from the bracket, shrinking it after each rejected proposal. the target
+// is left at the accepted point, or at the current parameters if the bracket collapsed.
+slice_line_counts slice_line_update(slice_target& target,
+                                    double threshold,
+                                    const arma::rowvec& direction,
+                                    double width) {
+
+      const double min_width = std::sqrt(std::numeric_limits<double>::epsilon());
+
+      if(target.batch_size() > 1) {
+            return slice_line_update_batch(target, threshold, direction, width, min_width);
+      }
+
+      slice_line_counts counts = {false, 0, 0};
+      arma::rowvec origin      = target.params_est();
+
+      // construct the approximate bracket
+      double lower = -width * R::runif(0.0, 1.0);
+      double upper = lower + width;
+
+      // step out the bracket
+      while(threshold < target.log_posterior(origin + lower * direction)) {
+            lower -= width;
+            counts.n_expansions += 1;
+      }
+
+      while(threshold < target.log_posterior(origin + upper * direction)) {
+            upper += width;
+            counts.n_expansions += 1;
+      }
+
+      // sample from the bracket
+      double logpost_prop = R_NegInf;
+
+      while((upper - lower) > min_width && logpost_prop < threshold) {
+
+            double prop  = R::runif(lower, upper);
+            logpost_prop = target.log_posterior(origin + prop * direction);
+
+            if(threshold > logpost_prop) {
+
+                  if(prop < 0) {
+                        lower = prop;
+                  } else {
+                        upper = prop;
+                  }
+
+                  counts.n_contractions += 1;
+            }
+      }
+
+      counts.accepted = (upper - lower) > min_width;
+
+      if(counts.accepted) {
+            target.accept();
+      } else {
+            target.restore();
+      }
+
+      return counts;
+}
@@ -0,0 +1,373 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "slice_target.h"
+#include "stemr_parallel.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+slice_target::slice_target(const Rcpp::List& priors,
+                           const Rcpp::List& tparam,
+                           Rcpp::NumericVector& model_params_est,
+                           Rcpp::NumericVector& model_params_nat,
+                           Rcpp::NumericVector& params_prop_est,
+                           Rcpp::NumericVector& params_prop_nat,
+                           Rcpp::NumericVector& params_logprior_cur,
+                           Rcpp::NumericVector& data_log_lik,
+                           Rcpp::NumericMatrix& params_cur,
+                           Rcpp::NumericVector& param_vec,
+                           Rcpp::NumericMatrix& path_cur,
+                           Rcpp::NumericMatrix& pathmat_prop,
+                           Rcpp::NumericMatrix& censusmat,
+                           Rcpp::NumericMatrix& emitmat,
+                           const Rcpp::NumericMatrix& data,
+                           const Rcpp::List& obs_layout,
+                           const arma::mat& flow_matrix,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           const Rcpp::IntegerVector& param_inds,
+                           const Rcpp::IntegerVector& const_inds,
+                           const Rcpp::IntegerVector& tcovar_inds,
+                           const Rcpp::IntegerVector& initdist_inds,
+                           const arma::uvec& path_par_inds,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::uvec& event_inds,
+                           const Rcpp::IntegerVector& census_indices,
+                           SEXP d_meas_pointer,
+                           bool do_prevalence,
+                           SEXP ode_cache,
+                           path_mapper map_path) :
+      from_estimation_scale(Rcpp::as<Rcpp::Function>(priors["from_estimation_scale"])),
+      prior_density(Rcpp::as<Rcpp::Function>(priors["prior_density"])),
+      compiled_priors(priors.containsElementNamed("prior_pointers")),
+      prior_ptr(compiled_priors ?
+                VECTOR_ELT(priors["prior_pointers"], 0) : R_NilValue),
+      from_est_ptr(compiled_priors ?
+                   VECTOR_ELT(priors["prior_pointers"], 2) : R_NilValue),
+      tparam(tparam),
+      params_prop_est_R(params_prop_est),
+      params_prop_nat_R(params_prop_nat),
+      params_cur_R(params_cur),
+      censusmat_R(censusmat),
+      emitmat_R(emitmat),
+      model_est(model_params_est.begin(), model_params_est.size(), false, true),
+      model_nat(model_params_nat.begin(), model_params_nat.size(), false, true),
+      prop_est(params_prop_est.begin(), params_prop_est.size(), false, true),
+      prop_nat(params_prop_nat.begin(), params_prop_nat.size(), false, true),
+      logprior_cur(params_logprior_cur.begin(), 1, false, true),
+      loglik_cur(data_log_lik.begin(), 1, false, true),
+      pars(params_cur.begin(), params_cur.nrow(), params_cur.ncol(), false, true),
+      path(path_cur, pathmat_prop),
+      census(censusmat.begin(), censusmat.nrow(), censusmat.ncol(), false, true),
+      emit(emitmat.begin(), emitmat.nrow(), emitmat.ncol(), false, true),
+      param_vec(param_vec),
+      data(data),
+      obs_layout(obs_layout),
+      par_names(Rf_isNull(Rf_getAttrib(params_cur, R_DimNamesSymbol)) ?
+                R_NilValue : VECTOR_ELT(Rf_getAttrib(params_cur, R_DimNamesSymbol), 1)),
+      flow_matrix(flow_matrix),
+      forcing_inds(forcing_inds),
+      forcing_tcov_inds(forcing_tcov_inds),
+      forcings_out(forcings_out),
+      forcing_transfers(forcing_transfers),
+      param_inds(param_inds),
+      const_inds(const_inds),
+      tcovar_inds(tcovar_inds),
+      initdist_inds(initdist_inds),
+      path_par_inds(path_par_inds),
+      param_update_inds(param_update_inds),
+      event_inds(event_inds),
+      census_indices(census_indices),
+      census_inds(Rcpp::as<arma::uvec>(census_indices)),
+      d_meas_pointer(d_meas_pointer),
+      do_prevalence(do_prevalence),
+      ode_cache(ode_cache),
+      map_path(map_path),
+      logprior_prop(R_NegInf),
+      loglik_prop(R_NegInf),
+      path_fixed(false),
+      loglik_cached(false),
+      census_synced(false),
+      n_threads(1),
+      prior_fcn(nullptr),
+      from_est_fcn(nullptr),
+      d_meas_fcn(nullptr),
+      inv_temperature(1.0) {
+
+      for(int p = 0; p < tparam.size(); ++p) {
+            Rcpp::List tpar = tparam[p];
+            tpar_structures.emplace_back(has_tpar_structure(tpar) ?
+                                         new tpar_structure(Rcpp::as<Rcpp::List>(tpar["structure"])) : nullptr);
+      }
+}
+
+double slice_target::begin_update() {
+
+      set_reference();
+
+      return loglik_cur[0] + logprior_cur[0] - R::rexp(1.0);
+}
+
+void slice_target::set_reference() {
+
+      path_pars_ref = pars.cols(path_par_inds);
+}
+
+void slice_target::insert_tparams() {
+
+      for(int p = 0; p < tparam.size(); ++p) {
+
+            Rcpp::List tpar           = tparam[p];
+            Rcpp::NumericVector draws = tpar["draws_cur"];
+
+            if(tpar_structures[p]) {
+                  tpar_structures[p]->draws2par(tpar_values,
+                                                arma::vec(draws.begin(), draws.size(), false, true),
+                                                pars);
+
+                  insert_tparam(pars, tpar_values,
+                                Rcpp::as<int>(tpar["col_ind"]),
+                                Rcpp::as<arma::uvec>(tpar["tpar_inds"]));
+                  continue;
+            }
+
+            // the draws2par functions may refer to the parameters by name
+            Rcpp::NumericVector par_row(pars.n_cols);
+            for(int c = 0; c < par_row.size(); ++c) par_row[c] = pars(0, c);
+            if(!par_names.isNULL()) par_row.attr("names") = par_names;
+
+            Rcpp::Function draws2par = tpar["draws2par"];
+
+            insert_tparam(pars,
+                          Rcpp::as<arma::vec>(draws2par(Rcpp::Named("parameters") = par_row,
+                                                        Rcpp::Named("draws")      = draws)),
+                          Rcpp::as<int>(tpar["col_ind"]),
+                          Rcpp::as<arma::uvec>(tpar["tpar_inds"]));
+      }
+}
+
+double slice_target::log_posterior(const arma::rowvec& params_est) {
+
+      // get the parameters on the natural scale and compute the prior density
+      prop_est = params_est;
+
+      if(compiled_priors) {
+            CALL_PARAM_TRANSFORM(params_prop_nat_R, params_prop_est_R, from_est_ptr);
+            logprior_prop = CALL_PRIOR_DENSITY(params_prop_nat_R, params_prop_est_R, prior_ptr);
+
+      } else {
+            prop_nat = Rcpp::as<arma::rowvec>(from_estimation_scale(params_prop_est_R));
+
+            logprior_prop = Rcpp::as<double>(prior_density(Rcpp::Named("params_nat") = params_prop_nat_R,
+                                                           Rcpp::Named("params_est") = params_prop_est_R));
+      }
+
+      loglik_prop   = R_NegInf;
+      loglik_cached = false;
+
+      if(logprior_prop == R_NegInf) return R_NegInf;
+
+      // insert the parameters and the time-varying parameters into the parameter matrix
+      pars2lnapars2(pars, prop_nat, 0);
+      insert_tparams();
+
+      // the path only changes if the parameters that drive the dynamics changed
+      path_fixed = !path_pars_changed(pars, path_pars_ref, path_par_inds);
+
+      try {
+            if(!path_fixed) map_path(path.prop());
+
+            // reuse the log likelihood if these parameters were evaluated before
+            double loglik = ode_cache_loglik(ode_cache, pars, path_par_inds);
+            loglik_cached = !ISNAN(loglik);
+
+            if(!loglik_cached) {
+
+                  // emission only moves reuse the census of the current path
+                  if(!path_fixed || !census_synced) {
+                        census_synced = false;
+
+                        arma::rowvec init_state(initdist_inds.size());
+                        for(int j = 0; j < initdist_inds.size(); ++j) init_state[j] = pars(0, initdist_inds[j]);
+
+                        census_lna(path_fixed ? path.cur() : path.prop(), census, census_inds, event_inds,
+                                   flow_matrix, do_prevalence, init_state, pars, forcing_inds,
+                                   forcing_tcov_inds, forcings_out, forcing_transfers, 0);
+
+                        census_synced = path_fixed;
+                  }
+
+                  // evaluate the density of the incidence counts
+                  evaluate_d_measure_LNA(emitmat_R, data, censusmat_R, obs_layout, params_cur_R, param_inds,
+                                         const_inds, tcovar_inds, param_update_inds, census_indices,
+                                         param_vec, d_meas_pointer, 0);
+
+                  loglik = compute_data_log_lik(emit, obs_layout);
+                  ode_cache_set_loglik(ode_cache, pars, path_par_inds, loglik);
+            }
+
+            loglik_prop = ISNAN(loglik) ? R_NegInf : loglik;
+
+      } catch(std::exception&) {
+            loglik_prop = R_NegInf;
+      }
+
+      return loglik_prop + logprior_prop;
+}
+
+void slice_target::accept() {
+
+      // update vectors of model parameters and the likelihood terms
+      model_est       = prop_est;
+      model_nat       = prop_nat;
+      logprior_cur[0] = logprior_prop;
+      loglik_cur[0]   = loglik_prop;
+
+      // swap in the path if it was recomputed, the census corresponds to the path
+      // unless the log likelihood was retrieved from the cache
+      if(!path_fixed) path.accept();
+      census_synced = !loglik_cached || (path_fixed && census_synced);
+}
+
+void slice_target::restore() {
+
+      pars2lnapars2(pars, model_nat, 0);
+      insert_tparams();
+}
+
+bool slice_target::enable_batches(native_path_mapper map_native, SEXP d_meas_native_pointer, int n_threads) {
+
+      slots.clear();
+
+      if(n_threads < 2 || !compiled_priors || !map_native || Rf_isNull(d_meas_native_pointer)) return false;
+
+      for(unsigned int p = 0; p < tpar_structures.size(); ++p) {
+            if(!tpar_structures[p]) return false;
+      }
+
+      // read everything that lives in R objects before the points are evaluated off the main thread
+      prior_fcn    = *Rcpp::XPtr<prior_density_ptr>(prior_ptr);
+      from_est_fcn = *Rcpp::XPtr<param_transform_ptr>(from_est_ptr);
+      d_meas_fcn   = *Rcpp::XPtr<d_measure_native_ptr>(d_meas_native_pointer);
+
+      tpar_draws.clear();
+      tpar_cols.clear();
+      tpar_inds.clear();
+
+      for(int p = 0; p < tparam.size(); ++p) {
+            Rcpp::List tpar = tparam[p];
+            tpar_draws.push_back(Rcpp::as<arma::vec>(tpar["draws_cur"]));
+            tpar_cols.push_back(Rcpp::as<int>(tpar["col_ind"]));
+            tpar_inds.push_back(Rcpp::as<arma::uvec>(tpar["tpar_inds"]));
+      }
+
+      obs          = Rcpp::as<arma::mat>(data);
+      obs_row_ptr  = Rcpp::as<std::vector<int>>(obs_layout["row_ptr"]);
+      obs_col_inds = Rcpp::as<std::vector<int>>(obs_layout["col_inds"]);
+
+      Rcpp::List var_inds = obs_layout["var_inds"];
+      obs_var_rows.clear();
+      for(int m = 0; m < var_inds.size(); ++m) obs_var_rows.push_back(Rcpp::as<arma::uvec>(var_inds[m]));
+
+      inv_temperature = obs_layout.containsElementNamed("inv_temperature") ?
+            Rcpp::as<double>(obs_layout["inv_temperature"]) : 1.0;
+
+      param_inds_native  = Rcpp::as<arma::uvec>(param_inds);
+      const_inds_native  = Rcpp::as<arma::uvec>(const_inds);
+      tcovar_inds_native = Rcpp::as<arma::uvec>(tcovar_inds);
+
+      this->map_native = map_native;
+      this->n_threads  = n_threads;
+
+      // each slot has its own copies of everything written while a point is evaluated
+      slots.resize(n_threads);
+      for(auto& slot : slots) {
+            slot.prop_est.set_size(prop_est.n_elem);
+            slot.prop_nat.set_size(prop_nat.n_elem);
+            for(auto& structure : tpar_structures) slot.tpar_structures.push_back(*structure);
+      }
+
+      return true;
+}
+
+void slice_target::evaluate_slot(slice_slot& slot) {
+
+      slot.loglik     = R_NegInf;
+      slot.path_fixed = false;
+
+      from_est_fcn(slot.prop_nat.memptr(), slot.prop_est.memptr());
+      slot.logprior = prior_fcn(slot.prop_nat.memptr(), slot.prop_est.memptr());
+
+      if(slot.logprior == R_NegInf) return;
+
+      // insert the parameters and the time-varying parameters into the parameter matrix
+      pars2lnapars2(slot.pars, slot.prop_nat, 0);
+
+      for(unsigned int p = 0; p < slot.tpar_structures.size(); ++p) {
+            slot.tpar_structures[p].draws2par(slot.tpar_values, tpar_draws[p], slot.pars);
+            insert_tparam(slot.pars, slot.tpar_values, tpar_cols[p], tpar_inds[p]);
+      }
+
+      slot.path_fixed = !path_pars_changed(slot.pars, path_pars_ref, path_par_inds);
+
+      try {
+            if(!slot.path_fixed) map_native(slot.path, slot.pars, slot.workspace);
+
+            arma::rowvec init_state(initdist_inds.size());
+            for(int j = 0; j < initdist_inds.size(); ++j) init_state[j] = slot.pars(0, initdist_inds[j]);
+
+            census_lna(slot.path_fixed ? path.cur() : slot.path, slot.census, census_inds, event_inds,
+                       flow_matrix, do_prevalence, init_state, slot.pars, forcing_inds,
+                       forcing_tcov_inds, forcings_out, forcing_transfers, 0);
+
+            evaluate_d_measure_native(slot.emit, obs, slot.census, obs_row_ptr, obs_col_inds, slot.pars,
+                                      param_inds_native, const_inds_native, tcovar_inds_native,
+                                      param_update_inds, census_indices, d_meas_fcn);
+
+            double loglik = compute_data_log_lik_native(slot.emit, obs_var_rows, inv_temperature);
+            slot.loglik   = ISNAN(loglik) ? R_NegInf : loglik;
+
+      } catch(std::exception&) {
+            slot.loglik = R_NegInf;
+      }
+}
+
+void slice_target::log_posterior_batch(const std::vector<arma::rowvec>& points, arma::vec& logpost) {
+
+      int n_points = points.size();
+      logpost.set_size(n_points);
+
+      for(int k = 0; k < n_points; ++k) {
+            slots[k].prop_est = points[k];
+            slots[k].pars     = pars;
+            slots[k].path     = path.cur();
+            slots[k].census   = census;
+            slots[k].emit     = emit;
+      }
+
+      // the batched evaluations neither read nor fill the ODE cache
+      parallel_for(n_points, n_threads, [&](int k) {
+            evaluate_slot(slots[k]);
+            logpost[k] = slots[k].loglik + slots[k].logprior;
+      });
+}
+
+void slice_target::accept_batch(int k) {
+
+      slice_slot& slot = slots[k];
+
+      prop_est      = slot.prop_est;
+      prop_nat      = slot.prop_nat;
+      logprior_prop = slot.logprior;
+      loglik_prop   = slot.loglik;
+      path_fixed    = slot.path_fixed;
+      loglik_cached = false;
+
+      pars   = slot.pars;
+      census = slot.census;
+      emit   = slot.emit;
+      if(!path_fixed) path.prop() = slot.path;
+
+      accept();
+}
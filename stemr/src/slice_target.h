@@ -0,0 +1,229 @@
+#ifndef stemr_slice_target_h
+#define stemr_slice_target_h
+
+#include "stemr_types.h"
+#include "stemr_utils.h"
+#include "double_buffer.h"
+#include "tpar_structure.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// maps the parameter matrix to a path of incidence increments, LNA or ODE
+typedef std::function<void(arma::mat& pathmat)> path_mapper;
+
+// buffers used by a native path mapper
+struct path_workspace {
+      arma::vec svd_d;
+      arma::mat svd_U;
+      arma::mat svd_V;
+};
+
+// maps a parameter matrix to a path of incidence increments without calling into R, so that
+// paths can be mapped concurrently for the points of a batch
+typedef std::function<void(arma::mat& pathmat, const arma::mat& pars, path_workspace& workspace)> native_path_mapper;
+
+// a point of a batch, with its own copies of the matrices written while evaluating it
+struct slice_slot {
+      arma::rowvec prop_est;
+      arma::rowvec prop_nat;
+      arma::mat pars;
+      arma::mat path;
+      arma::mat census;
+      arma::mat emit;
+      std::vector<tpar_structure> tpar_structures;
+      arma::vec tpar_values;
+      path_workspace workspace;
+      double logprior;
+      double loglik;
+      bool path_fixed;
+};
+
+// log posterior of the model parameters for the slice samplers, with the latent path
+// held fixed. the parameter, path, census, and emission matrices are R objects that
+// are updated in place, as in the R implementations of the samplers. the current and proposed
+// paths are double buffered, the current path is written back to its R matrix on destruction.
+class slice_target {
+
+public:
+      slice_target(const Rcpp::List& priors,
+                   const Rcpp::List& tparam,
+                   Rcpp::NumericVector& model_params_est,
+                   Rcpp::NumericVector& model_params_nat,
+                   Rcpp::NumericVector& params_prop_est,
+                   Rcpp::NumericVector& params_prop_nat,
+                   Rcpp::NumericVector& params_logprior_cur,
+                   Rcpp::NumericVector& data_log_lik,
+                   Rcpp::NumericMatrix& params_cur,
+                   Rcpp::NumericVector& param_vec,
+                   Rcpp::NumericMatrix& path_cur,
+                   Rcpp::NumericMatrix& pathmat_prop,
+                   Rcpp::NumericMatrix& censusmat,
+                   Rcpp::NumericMatrix& emitmat,
+                   const Rcpp::NumericMatrix& data,
+                   const Rcpp::List& obs_layout,
+                   const arma::mat& flow_matrix,
+                   const Rcpp::LogicalVector& forcing_inds,
+                   const arma::uvec& forcing_tcov_inds,
+                   const arma::mat& forcings_out,
+                   const arma::cube& forcing_transfers,
+                   const Rcpp::IntegerVector& param_inds,
+                   const Rcpp::IntegerVector& const_inds,
+                   const Rcpp::IntegerVector& tcovar_inds,
+                   const Rcpp::IntegerVector& initdist_inds,
+                   const arma::uvec& path_par_inds,
+                   const Rcpp::LogicalVector& param_update_inds,
+                   const arma::uvec& event_inds,
+                   const Rcpp::IntegerVector& census_indices,
+                   SEXP d_meas_pointer,
+                   bool do_prevalence,
+                   SEXP ode_cache,
+                   path_mapper map_path);
+
+      // draw the slice threshold and record the parameters that determine the current path
+      double begin_update();
+
+      // record the parameters that determine the current path, for Metropolis updates
+      void set_reference();
+
+      // log posterior at a vector of parameters on the estimation scale
+      double log_posterior(const arma::rowvec& params_est);
+
+      // make the last evaluated point the current state
+      void accept();
+
+      // evaluate batches of up to batch_size points concurrently on n_threads threads. the points
+      // are evaluated through the compiled priors, the compiled structures of the time-varying
+      // parameters, the native path mapper, and the native measurement density, none of which call
+      // into R. returns false and leaves the target sequential unless all of these are available.
+      bool enable_batches(native_path_mapper map_native, SEXP d_meas_native_pointer, int n_threads);
+
+      // number of points that are evaluated concurrently, 1 if the target is sequential
+      int batch_size() const { return std::max<int>(slots.size(), 1); }
+
+      // log posterior at each of a batch of points on the estimation scale
+      void log_posterior_batch(const std::vector<arma::rowvec>& points, arma::vec& logpost);
+
+      // make point k of the last batch the current state
+      void accept_batch(int k);
+
+      // reinsert the current parameters into the parameter matrix
+      void restore();
+
+      // current parameters on the estimation and natural scales
+      const arma::rowvec& params_est() const { return model_est; }
+      const arma::rowvec& params_nat() const { return model_nat; }
+
+      // current path and likelihood terms
+      const arma::mat& path_cur() const { return path.cur(); }
+      double log_prior() const { return logprior_cur[0]; }
+      double log_lik() const { return loglik_cur[0]; }
+
+private:
+      void insert_tparams();
+      void evaluate_slot(slice_slot& slot);
+
+      Rcpp::Function from_estimation_scale;
+      Rcpp::Function prior_density;
+
+      // compiled prior density and transformation, used instead of the R functions if supplied
+      bool compiled_priors;
+      SEXP prior_ptr;
+      SEXP from_est_ptr;
+      Rcpp::List tparam;
+
+      // compiled structures of the time-varying parameters, null where draws2par is called in R
+      std::vector<std::unique_ptr<tpar_structure>> tpar_structures;
+      arma::vec tpar_values;
+
+      // R objects and the armadillo views of their memory
+      Rcpp::NumericVector params_prop_est_R;
+      Rcpp::NumericVector params_prop_nat_R;
+      Rcpp::NumericMatrix params_cur_R;
+      Rcpp::NumericMatrix censusmat_R;
+      Rcpp::NumericMatrix emitmat_R;
+
+      arma::rowvec model_est;
+      arma::rowvec model_nat;
+      arma::rowvec prop_est;
+      arma::rowvec prop_nat;
+      arma::rowvec logprior_cur;
+      arma::rowvec loglik_cur;
+      arma::mat pars;
+      double_buffer path;
+      arma::mat census;
+      arma::mat emit;
+
+      Rcpp::NumericVector param_vec;
+      Rcpp::NumericMatrix data;
+      Rcpp::List obs_layout;
+      Rcpp::RObject par_names;
+      const arma::mat& flow_matrix;
+      Rcpp::LogicalVector forcing_inds;
+      const arma::uvec& forcing_tcov_inds;
+      const arma::mat& forcings_out;
+      const arma::cube& forcing_transfers;
+      Rcpp::IntegerVector param_inds;
+      Rcpp::IntegerVector const_inds;
+      Rcpp::IntegerVector tcovar_inds;
+      Rcpp::IntegerVector initdist_inds;
+      const arma::uvec& path_par_inds;
+      Rcpp::LogicalVector param_update_inds;
+      const arma::uvec& event_inds;
+      Rcpp::IntegerVector census_indices;
+      arma::uvec census_inds;
+      SEXP d_meas_pointer;
+      bool do_prevalence;
+      SEXP ode_cache;
+      path_mapper map_path;
+
+      // parameter matrix columns that determine the current path
+      arma::mat path_pars_ref;
+
+      // state of the last evaluated point
+      double logprior_prop;
+      double loglik_prop;
+      bool path_fixed;
+      bool loglik_cached;
+
+      // is the census matrix computed from the current path
+      bool census_synced;
+
+      // batched evaluation, the slots hold the points of the last batch
+      std::vector<slice_slot> slots;
+      int n_threads;
+      native_path_mapper map_native;
+      prior_density_ptr prior_fcn;
+      param_transform_ptr from_est_fcn;
+      d_measure_native_ptr d_meas_fcn;
+
+      // the time-varying parameter draws and the observation layout, read before the batches
+      std::vector<arma::vec> tpar_draws;
+      std::vector<int> tpar_cols;
+      std::vector<arma::uvec> tpar_inds;
+      arma::mat obs;
+      std::vector<int> obs_row_ptr;
+      std::vector<int> obs_col_inds;
+      std::vector<arma::uvec> obs_var_rows;
+      double inv_temperature;
+      arma::uvec param_inds_native;
+      arma::uvec const_inds_native;
+      arma::uvec tcovar_inds_native;
+};
+
+// numbers of bracket expansions and contractions in a slice sampling update along a line
+struct slice_line_counts {
+      bool accepted;
+      int n_expansions;
+      int n_contractions;
+};
+
+// univariate slice sampling update along a line through the current parameters, the candidate
+// points are evaluated in batches if the target evaluates batches
+slice_line_counts slice_line_update(slice_target& target,
+                                    double threshold,
+                                    const arma::rowvec& direction,
+                                    double width);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef stemr_parallel_h
+#define stemr_parallel_h
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// run fcn(i) for i = 0,...,n-1, split into contiguous blocks over n_threads threads.
+// fcn must not call into R. the first exception thrown by a worker is rethrown.
+template <typename Fcn>
+void parallel_for(int n, int n_threads, Fcn fcn) {
+
+      n_threads = std::max(1, std::min(n_threads, n));
+
+      if(n_threads == 1) {
+            for(int i = 0; i < n; ++i) fcn(i);
+            return;
+      }
+
+      std::vector<std::thread> workers;
+      std::vector<std::exception_ptr> errors(n_threads);
+      workers.reserve(n_threads);
+
+      for(int t = 0; t < n_threads; ++t) {
+
+            int block_start = (n * t) / n_threads;
+            int block_end   = (n * (t + 1)) / n_threads;
+
+            workers.emplace_back([&fcn, &errors, t, block_start, block_end]() {
+                  try {
+                        for(int i = block_start; i < block_end; ++i) fcn(i);
+                  } catch(...) {
+                        errors[t] = std::current_exception();
+                  }
+            });
+      }
+
+      for(auto& worker : workers) worker.join();
+
+      for(auto& error : errors) {
+            if(error) std::rethrow_exception(error);
+      }
+}
+
+#endif
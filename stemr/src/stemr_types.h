@@ -2,6 +2,7 @@
 #define stemr_types_h
 
 #include <RcppArmadillo.h>
+#include <random>
 
 using namespace arma;
 using namespace Rcpp;
@@ -19,8 +20,25 @@ typedef void(*r_measure_ptr)(Rcpp::NumericMatrix& obsmat, const Rcpp::LogicalVec
              const int record_ind, const Rcpp::NumericVector& state, const Rcpp::NumericVector& parameters,
              const Rcpp::NumericVector& constants, const Rcpp::NumericVector& tcovar);
 
+// thread safe measurement process simulation, does not call into R
+typedef void(*r_measure_native_ptr)(double* obs, const int* emit_inds, const double* state,
+             const double* parameters, const double* constants, const double* tcovar,
+             std::mt19937_64& rng);
+
 // odeintr pointers
 typedef void(*ode_ptr)(Rcpp::NumericVector& init, double start, double end, double step_size);
 typedef void(*set_pars_ptr)(Rcpp::NumericVector& p);
 
+// thread safe ODE or LNA integration with the parameters passed in, does not call into R
+typedef void(*ode_native_ptr)(double* init, const double* pars, double start, double end, double step_size);
+
+// thread safe measurement process density for a single row, does not call into R
+typedef void(*d_measure_native_ptr)(double* emit, const int* emit_inds, const double* record,
+             const double* state, const double* parameters, const double* constants,
+             const double* tcovar);
+
+// compiled priors and parameter transformations, do not call into R
+typedef double(*prior_density_ptr)(const double* params_nat, const double* params_est);
+typedef void(*param_transform_ptr)(double* dest, const double* orig);
+
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define stemr_UTILITIES_H
 
 #include <RcppArmadillo.h>
+#include "stemr_types.h"
 #include <algorithm>
 #include <math.h>
 #include <boost/numeric/odeint.hpp>
@@ -51,6 +52,16 @@ void CALL_INTEGRATE_STEM_ODE(Rcpp::NumericVector& init,
 void CALL_SET_ODE_PARAMS(Rcpp::NumericVector& p,
                          SEXP set_ode_params_ptr);
 
+// evaluate a compiled prior density, call via XPtr
+double CALL_PRIOR_DENSITY(const Rcpp::NumericVector& params_nat,
+                          const Rcpp::NumericVector& params_est,
+                          SEXP prior_ptr);
+
+// transform parameters to or from their estimation scales, call via XPtr
+void CALL_PARAM_TRANSFORM(Rcpp::NumericVector& dest,
+                          const Rcpp::NumericVector& orig,
+                          SEXP transform_ptr);
+
 // update rates based on transition events or changes in time-varying covariates
 void rate_update_tcovar(Rcpp::LogicalVector& rate_inds,
                         const arma::mat& M,
@@ -95,7 +106,189 @@ void census_lna(const arma::mat& path,
                 const arma::mat& flow_matrix_lna,
                 bool do_prevalence,
                 const arma::rowvec& init_state,
-                const arma::mat& forcing_matrix);
+                const arma::mat& lna_pars,
+                const Rcpp::LogicalVector& forcing_inds,
+                const arma::uvec& forcing_tcov_inds,
+                const arma::mat& forcings_out,
+                const arma::cube& forcing_transfers,
+                int census_start);
+
+// evaluate the emission densities for the LNA or ODE census matrix
+void evaluate_d_measure_LNA(Rcpp::NumericMatrix& emitmat,
+                            const Rcpp::NumericMatrix& obsmat,
+                            const Rcpp::NumericMatrix& censusmat,
+                            const Rcpp::List& obs_layout,
+                            const Rcpp::NumericMatrix& lna_parameters,
+                            const Rcpp::IntegerVector& lna_param_inds,
+                            const Rcpp::IntegerVector& lna_const_inds,
+                            const Rcpp::IntegerVector& lna_tcovar_inds,
+                            const Rcpp::LogicalVector& param_update_inds,
+                            const Rcpp::IntegerVector& census_indices,
+                            Rcpp::NumericVector& lna_param_vec,
+                            SEXP d_meas_ptr,
+                            int row_start);
+
+// evaluate the emission densities through a native density function, does not call into R
+void evaluate_d_measure_native(arma::mat& emitmat,
+                               const arma::mat& obsmat,
+                               const arma::mat& censusmat,
+                               const std::vector<int>& row_ptr,
+                               const std::vector<int>& col_inds,
+                               const arma::mat& lna_parameters,
+                               const arma::uvec& lna_param_inds,
+                               const arma::uvec& lna_const_inds,
+                               const arma::uvec& lna_tcovar_inds,
+                               const Rcpp::LogicalVector& param_update_inds,
+                               const Rcpp::IntegerVector& census_indices,
+                               d_measure_native_ptr d_meas_fcn);
+
+// sum the observed entries of the emission matrix
+double compute_data_log_lik(const arma::mat& emitmat, const Rcpp::List& obs_layout);
+double compute_data_log_lik_native(const arma::mat& emitmat,
+                                   const std::vector<arma::uvec>& var_rows,
+                                   double inv_temperature);
+
+// update the data log likelihood contributions from a row of the emission matrix onwards
+double update_data_log_lik(arma::vec& loglik_rows,
+                           const arma::mat& emitmat,
+                           const Rcpp::List& obs_layout,
+                           int row_start);
+
+// find the first census interval affected by a change in the path or parameters
+int find_dirty_range(arma::mat& path_ref,
+                     const arma::mat& path,
+                     arma::mat& pars_ref,
+                     const arma::mat& lna_pars,
+                     const arma::uvec& census_inds,
+                     bool reset);
+
+// check whether the parameters that determine the path changed
+bool path_pars_changed(const arma::mat& pars, const arma::mat& pars_ref, const arma::uvec& col_inds);
+
+// map N(0,1) draws to the LNA incidence increments
+void map_draws_2_lna(arma::mat& pathmat,
+                     const arma::mat& draws,
+                     const arma::rowvec& lna_times,
+                     const Rcpp::NumericMatrix& lna_pars,
+                     Rcpp::NumericVector& lna_param_vec,
+                     const Rcpp::IntegerVector& lna_param_inds,
+                     const Rcpp::IntegerVector& lna_tcovar_inds,
+                     const int init_start,
+                     const Rcpp::LogicalVector& param_update_inds,
+                     const arma::mat& stoich_matrix,
+                     const Rcpp::LogicalVector& forcing_inds,
+                     const arma::uvec& forcing_tcov_inds,
+                     const arma::mat& forcings_out,
+                     const arma::cube& forcing_transfers,
+                     arma::vec& svd_d,
+                     arma::mat& svd_U,
+                     arma::mat& svd_V,
+                     double step_size,
+                     SEXP lna_pointer,
+                     SEXP set_pars_pointer);
+
+// map N(0,1) draws to the LNA incidence increments through the native integrator, does not call into R
+void map_draws_2_lna_native(arma::mat& pathmat,
+                            const arma::mat& draws,
+                            const arma::rowvec& lna_times,
+                            const arma::mat& lna_pars,
+                            const int n_tcovar,
+                            const int init_start,
+                            const Rcpp::LogicalVector& param_update_inds,
+                            const arma::mat& stoich_matrix,
+                            const Rcpp::LogicalVector& forcing_inds,
+                            const arma::uvec& forcing_tcov_inds,
+                            const arma::mat& forcings_out,
+                            const arma::cube& forcing_transfers,
+                            arma::vec& svd_d,
+                            arma::mat& svd_U,
+                            arma::mat& svd_V,
+                            double step_size,
+                            ode_native_ptr lna_native);
+
+// map N(0,1) draws to an LNA path and accumulate its census in the same pass
+void map_draws_2_lna_census(arma::mat& pathmat,
+                            const arma::mat& draws,
+                            const arma::rowvec& lna_times,
+                            const Rcpp::NumericMatrix& lna_pars,
+                            Rcpp::NumericVector& lna_param_vec,
+                            const Rcpp::IntegerVector& lna_param_inds,
+                            const Rcpp::IntegerVector& lna_tcovar_inds,
+                            const int init_start,
+                            const Rcpp::LogicalVector& param_update_inds,
+                            const arma::mat& stoich_matrix,
+                            const Rcpp::LogicalVector& forcing_inds,
+                            const arma::uvec& forcing_tcov_inds,
+                            const arma::mat& forcings_out,
+                            const arma::cube& forcing_transfers,
+                            arma::vec& svd_d,
+                            arma::mat& svd_U,
+                            arma::mat& svd_V,
+                            double step_size,
+                            SEXP lna_pointer,
+                            SEXP set_pars_pointer,
+                            arma::mat& census_path,
+                            const arma::uvec& census_inds,
+                            const arma::uvec& lna_event_inds,
+                            const arma::mat& flow_matrix_lna,
+                            bool do_prevalence,
+                            const arma::rowvec& init_state,
+                            bool store_path);
+
+// map parameters to the deterministic incidence increments
+void map_pars_2_ode(arma::mat& pathmat,
+                    const arma::rowvec& ode_times,
+                    const Rcpp::NumericMatrix& ode_pars,
+                    const Rcpp::IntegerVector& ode_param_inds,
+                    const Rcpp::IntegerVector& ode_tcovar_inds,
+                    const int init_start,
+                    const Rcpp::LogicalVector& param_update_inds,
+                    const arma::mat& stoich_matrix,
+                    const Rcpp::LogicalVector& forcing_inds,
+                    const arma::uvec& forcing_tcov_inds,
+                    const arma::mat& forcings_out,
+                    const arma::cube& forcing_transfers,
+                    double step_size,
+                    SEXP ode_pointer,
+                    SEXP set_pars_pointer);
+
+// map parameters to the deterministic incidence increments through the native integrator, does not call into R
+void map_pars_2_ode_native(arma::mat& pathmat,
+                           const arma::rowvec& ode_times,
+                           const arma::mat& ode_pars,
+                           const int n_tcovar,
+                           const int init_start,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::mat& stoich_matrix,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           double step_size,
+                           ode_native_ptr ode_native);
+
+// ode path cache
+bool map_pars_2_ode_cached(SEXP ode_cache,
+                           const arma::uvec& key_inds,
+                           arma::mat& pathmat,
+                           const arma::rowvec& ode_times,
+                           const Rcpp::NumericMatrix& ode_pars,
+                           const Rcpp::IntegerVector& ode_param_inds,
+                           const Rcpp::IntegerVector& ode_tcovar_inds,
+                           const int init_start,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const arma::mat& stoich_matrix,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           double step_size,
+                           SEXP ode_pointer,
+                           SEXP set_pars_pointer);
+
+double ode_cache_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds);
+void ode_cache_set_loglik(SEXP ode_cache, const arma::mat& ode_pars, const arma::uvec& key_inds, double loglik);
+void ode_cache_set_origin(SEXP ode_cache, double origin);
 
 // update a census matrix with compartment counts at observation times
 void retrieve_census_path(arma::mat& cencusmat,
@@ -149,7 +342,7 @@ void copy_pathmat(arma::mat& dest, const arma::mat& orig);
 void copy_vec(arma::rowvec& dest, const arma::rowvec& orig);
 void copy_vec2(arma::rowvec& dest, const arma::rowvec& orig, const arma::uvec& inds);
 void copy_mat(arma::mat& dest, const arma::mat& orig);
-void increment_elem(arma::vec& vec, int ind);
+void increment_elem(arma::vec& vec, int ind, double amount = 1);
 void insert_block(arma::mat& dest, const arma::mat& orig, const arma::uvec& rowinds, const arma::uvec& colinds);
 void insert_tparam(arma::mat& tcovar, const arma::vec& values, int col_ind, const arma::uvec& tpar_inds);
 void mat_2_arr(arma::cube& dest, const arma::mat& orig, int ind);
@@ -160,6 +353,15 @@ void reset_vec(arma::vec& v, double value = 0);
 // comp_chol
 void comp_chol(arma::mat& C, arma::mat& M);
 
+// rank-one updates of the adaptive kernel covariance and its cholesky factor
+void chol_update(arma::mat& R, arma::vec x);
+void update_kernel_cov(arma::vec& kernel_mean,
+                       arma::mat& kernel_cov,
+                       arma::mat& kernel_chol,
+                       arma::vec& kernel_resid,
+                       const arma::vec& params_est,
+                       double adaptation);
+
 // reset slice ratios
 void reset_slice_ratios(arma::vec& n_expansions,
                         arma::vec& n_contractions,
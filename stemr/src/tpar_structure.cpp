@@ -0,0 +1,123 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "tpar_structure.h"
+
+using namespace Rcpp;
+using namespace arma;
+
+// codes for the process types and links
+static int tpar_type_code(const std::string& type) {
+      if(type == "rw1") return 1;
+      if(type == "rw2") return 2;
+      if(type == "rw3") return 3;
+      if(type == "ar1") return 4;
+      if(type == "bspline") return 5;
+      Rcpp::stop("Unknown time-varying parameter structure: " + type);
+}
+
+static int tpar_link_code(const std::string& link) {
+      if(link == "identity") return 0;
+      if(link == "log") return 1;
+      if(link == "logit") return 2;
+      Rcpp::stop("Unknown time-varying parameter link: " + link);
+}
+
+void tpar_map(arma::vec& values,
+              const arma::vec& draws,
+              const arma::vec& hyper,
+              int type,
+              int link,
+              const arma::mat& basis) {
+
+      const double intercept = hyper[0];
+      const double sd        = hyper[1];
+      const double init_sd   = hyper[2];
+      const double rho       = hyper[3];
+
+      if(type == 5) {
+
+            // B-spline basis with independent coefficients
+            values = intercept + basis * (sd * draws.head(basis.n_cols));
+
+      } else if(type == 4) {
+
+            // stationary AR(1) process about the intercept
+            values[0] = intercept + sd / std::sqrt(1.0 - rho * rho) * draws[0];
+
+            for(unsigned int t = 1; t < values.n_elem; ++t) {
+                  values[t] = intercept + rho * (values[t-1] - intercept) + sd * draws[t];
+            }
+
+      } else {
+
+            // random walk of order type, the first values start the walk with differences of
+            // increasing order whose increments have standard deviation init_sd
+            for(unsigned int t = 0; t < values.n_elem; ++t) {
+
+                  int order    = std::min(static_cast<int>(t), type);
+                  double value = (t == 0) ? intercept : 0.0;
+                  double coef  = 1.0;
+
+                  for(int j = 1; j <= order; ++j) {
+                        coef  *= static_cast<double>(order - j + 1) / j;
+                        value += ((j % 2 == 1) ? coef : -coef) * values[t-j];
+                  }
+
+                  values[t] = value + ((static_cast<int>(t) < type) ? init_sd : sd) * draws[t];
+            }
+      }
+
+      // apply the link
+      if(link == 1) {
+            values = arma::exp(values);
+      } else if(link == 2) {
+            values = 1.0 / (1.0 + arma::exp(-values));
+      }
+}
+
+tpar_structure::tpar_structure(const Rcpp::List& structure) :
+      type(tpar_type_code(Rcpp::as<std::string>(structure["type"]))),
+      link(tpar_link_code(Rcpp::as<std::string>(structure["link"]))),
+      n_values(Rcpp::as<int>(structure["n_values"])),
+      hyper_inds(Rcpp::as<arma::ivec>(structure["hyper_inds"])),
+      hyper_fixed(Rcpp::as<arma::vec>(structure["hyper_fixed"])),
+      basis(Rcpp::as<arma::mat>(structure["basis"])),
+      hyper(hyper_fixed) {}
+
+void tpar_structure::draws2par(arma::vec& values, const arma::vec& draws, const arma::mat& pars) const {
+
+      for(unsigned int h = 0; h < hyper.n_elem; ++h) {
+            if(hyper_inds[h] >= 0) hyper[h] = pars(0, hyper_inds[h]);
+      }
+
+      values.set_size(n_values);
+      tpar_map(values, draws, hyper, type, link, basis);
+}
+
+//' Map N(0,1) draws to the values of a time-varying parameter with a compiled
+//' structure.
+//'
+//' @param draws vector of N(0,1) draws
+//' @param hyper vector with the intercept, the standard deviation of the
+//'   increments, the standard deviation of the initial values, and the AR(1)
+//'   coefficient
+//' @param type one of "rw1", "rw2", "rw3", "ar1", or "bspline"
+//' @param link one of "identity", "log", or "logit"
+//' @param basis matrix of B-spline basis functions evaluated at the times when
+//'   the parameter changes, empty for other types
+//' @param n_values number of values of the time-varying parameter
+//'
+//' @return vector of values of the time-varying parameter
+//' @export
+// [[Rcpp::export]]
+arma::vec tpar_draws2par(const arma::vec& draws,
+                         const arma::vec& hyper,
+                         std::string type,
+                         std::string link,
+                         const arma::mat& basis,
+                         int n_values) {
+
+      arma::vec values(n_values);
+      tpar_map(values, draws, hyper, tpar_type_code(type), tpar_link_code(link), basis);
+
+      return values;
+}
@@ -0,0 +1,39 @@
+#ifndef stemr_tpar_structure_h
+#define stemr_tpar_structure_h
+
+#include <RcppArmadillo.h>
+
+// compiled map from N(0,1) draws to the values of a time-varying parameter, parsed once from
+// the structure list of a tpar. the hyperparameters are the intercept, the standard deviation
+// of the increments, the standard deviation of the initial values, and the AR(1) coefficient,
+// each either fixed or read from a column of the first row of the parameter matrix.
+struct tpar_structure {
+
+      explicit tpar_structure(const Rcpp::List& structure);
+
+      // map the draws to the parameter values
+      void draws2par(arma::vec& values, const arma::vec& draws, const arma::mat& pars) const;
+
+      int type;
+      int link;
+      int n_values;
+      arma::ivec hyper_inds;
+      arma::vec hyper_fixed;
+      arma::mat basis;
+      mutable arma::vec hyper;
+};
+
+// map N(0,1) draws to the values of a random walk, AR(1), or B-spline process with a link
+void tpar_map(arma::vec& values,
+              const arma::vec& draws,
+              const arma::vec& hyper,
+              int type,
+              int link,
+              const arma::mat& basis);
+
+// does the tpar have a compiled structure
+inline bool has_tpar_structure(const Rcpp::List& tpar) {
+      return tpar.containsElementNamed("structure") && !Rf_isNull(tpar["structure"]);
+}
+
+#endif
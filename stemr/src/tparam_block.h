@@ -0,0 +1,68 @@
+#ifndef stemr_tparam_block_h
+#define stemr_tparam_block_h
+
+#include "stemr_utils.h"
+#include "tpar_structure.h"
+#include <memory>
+#include <vector>
+
+// a time-varying parameter with a compiled structure, with views of its draws
+class tparam_block {
+
+public:
+      explicit tparam_block(const Rcpp::List& tpar) :
+            structure(Rcpp::as<Rcpp::List>(tpar["structure"])),
+            draws_cur_R(tpar["draws_cur"]),
+            draws_prop_R(tpar["draws_prop"]),
+            draws_ess_R(tpar["draws_ess"]),
+            draws_cur(draws_cur_R.begin(), draws_cur_R.size(), false, true),
+            draws_prop(draws_prop_R.begin(), draws_prop_R.size(), false, true),
+            draws_ess(draws_ess_R.begin(), draws_ess_R.size(), false, true),
+            col_ind(Rcpp::as<int>(tpar["col_ind"])),
+            tpar_inds(Rcpp::as<arma::uvec>(tpar["tpar_inds"])) {}
+
+      // draw new perturbations that define the ellipse
+      void draw_ellipse() { draw_normals(draws_prop); }
+
+      // insert the values at an angle on the ellipse into the parameter matrix
+      void propose(double theta, arma::mat& pars) {
+            draws_ess = std::cos(theta) * draws_cur + std::sin(theta) * draws_prop;
+            insert(draws_ess, pars);
+      }
+
+      void accept() { draws_cur = draws_ess; }
+
+      // reinsert the current values into the parameter matrix
+      void restore(arma::mat& pars) { insert(draws_cur, pars); }
+
+private:
+      void insert(const arma::vec& draws, arma::mat& pars) {
+            structure.draws2par(values, draws, pars);
+            insert_tparam(pars, values, col_ind, tpar_inds);
+      }
+
+      tpar_structure structure;
+      Rcpp::NumericVector draws_cur_R;
+      Rcpp::NumericVector draws_prop_R;
+      Rcpp::NumericVector draws_ess_R;
+      arma::vec draws_cur;
+      arma::vec draws_prop;
+      arma::vec draws_ess;
+      arma::vec values;
+      int col_ind;
+      arma::uvec tpar_inds;
+};
+
+typedef std::vector<std::unique_ptr<tparam_block>> tparam_blocks;
+
+inline tparam_blocks get_tparam_blocks(const Rcpp::List& tparam) {
+
+      tparam_blocks blocks;
+      for(int p = 0; p < tparam.size(); ++p) {
+            blocks.emplace_back(new tparam_block(Rcpp::as<Rcpp::List>(tparam[p])));
+      }
+
+      return blocks;
+}
+
+#endif
@@ -0,0 +1,283 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include "stemr_utils.h"
+#include "double_buffer.h"
+#include "tparam_block.h"
+#include <functional>
+
+using namespace Rcpp;
+using namespace arma;
+
+// elliptical slice sampling updates of the draws of the time-varying parameters, shared by the
+// LNA and ODE. proposal_loglik maps the path for the parameters in the parameter matrix into the
+// proposal buffer and returns the data log likelihood, -Inf if the path could not be computed.
+static void tparam_ess(tparam_blocks& blocks,
+                       arma::mat& pars,
+                       double_buffer& path,
+                       Rcpp::NumericVector& data_log_lik,
+                       const std::function<double(arma::mat&)>& proposal_loglik,
+                       Rcpp::NumericVector& tparam_steps,
+                       Rcpp::NumericVector& tparam_angle,
+                       double tparam_bracket_width,
+                       int n_tparam_updates) {
+
+      const double min_width = std::sqrt(arma::datum::eps);
+      double step_count = 1.0;
+
+      for(int k = 0; k < n_tparam_updates; ++k) {
+
+            // choose a likelihood threshold
+            double threshold = data_log_lik[0] + std::log(R::unif_rand());
+
+            // initial proposal, which also defines a bracket
+            double lower = -tparam_bracket_width * R::unif_rand();
+            double upper = lower + tparam_bracket_width;
+            double theta = R::runif(lower, upper);
+
+            for(auto& b : blocks) {
+                  b->draw_ellipse();
+                  b->propose(theta, pars);
+            }
+
+            double loglik = proposal_loglik(path.prop());
+
+            // continue proposing if not accepted
+            while((upper - lower) > min_width && loglik < threshold) {
+
+                  step_count += 1;
+
+                  // shrink the bracket and sample a new point
+                  if(theta < 0) {
+                        lower = theta;
+                  } else {
+                        upper = theta;
+                  }
+
+                  theta = R::runif(lower, upper);
+
+                  for(auto& b : blocks) b->propose(theta, pars);
+                  loglik = proposal_loglik(path.prop());
+            }
+
+            // if the bracket width is not equal to zero, update the draws, path, and data log likelihood
+            if((upper - lower) > min_width) {
+                  for(auto& b : blocks) b->accept();
+                  path.accept();
+                  data_log_lik[0] = loglik;
+
+            } else {
+                  for(auto& b : blocks) b->restore(pars);
+            }
+
+            tparam_steps[0] = step_count;
+            tparam_angle[0] = theta;
+      }
+}
+
+//' Update the time-varying parameters of an LNA model via elliptical slice
+//' sampling, natively.
+//'
+//' All time-varying parameters must have compiled structures, see
+//' \code{\link{tpar_structure}}. The draws, path, likelihood terms, and the
+//' likelihood cache are updated in place. Arguments are as in
+//' \code{\link{update_tparam_lna}}.
+//'
+//' @inheritParams update_tparam_lna
+//'
+//' @return update the time-varying parameters and the path in place
+//' @export
+// [[Rcpp::export]]
+void tparam_ess_update_lna(const Rcpp::List& tparam,
+                           const Rcpp::List& path_cur,
+                           const Rcpp::NumericMatrix& data,
+                           Rcpp::NumericMatrix& lna_parameters,
+                           Rcpp::NumericVector& lna_param_vec,
+                           Rcpp::NumericMatrix& pathmat_prop,
+                           Rcpp::NumericMatrix& censusmat,
+                           Rcpp::NumericMatrix& emitmat,
+                           const arma::mat& flow_matrix,
+                           const arma::mat& stoich_matrix,
+                           const arma::rowvec& lna_times,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           const Rcpp::IntegerVector& lna_param_inds,
+                           const Rcpp::IntegerVector& lna_const_inds,
+                           const Rcpp::IntegerVector& lna_tcovar_inds,
+                           const Rcpp::IntegerVector& lna_initdist_inds,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const Rcpp::IntegerVector& census_indices,
+                           const arma::uvec& lna_event_inds,
+                           const Rcpp::List& obs_layout,
+                           arma::vec& svd_d,
+                           arma::mat& svd_U,
+                           arma::mat& svd_V,
+                           SEXP lna_pointer,
+                           SEXP lna_set_pars_pointer,
+                           SEXP d_meas_pointer,
+                           bool do_prevalence,
+                           double step_size,
+                           Rcpp::NumericVector& tparam_steps,
+                           Rcpp::NumericVector& tparam_angle,
+                           double tparam_bracket_width,
+                           int n_tparam_updates,
+                           const Rcpp::List& lik_cache) {
+
+      // the current path, perturbations, and data log likelihood
+      Rcpp::NumericMatrix lna_path     = path_cur["lna_path"];
+      Rcpp::NumericMatrix draws_R      = path_cur["draws"];
+      Rcpp::NumericVector data_log_lik = path_cur["data_log_lik"];
+      const arma::mat draws(draws_R.begin(), draws_R.nrow(), draws_R.ncol(), false, true);
+
+      // the likelihood cache
+      Rcpp::NumericMatrix path_ref_R    = lik_cache["path_ref"];
+      Rcpp::NumericMatrix pars_ref_R    = lik_cache["pars_ref"];
+      Rcpp::NumericVector loglik_rows_R = lik_cache["loglik_rows"];
+      arma::mat path_ref(path_ref_R.begin(), path_ref_R.nrow(), path_ref_R.ncol(), false, true);
+      arma::mat pars_ref(pars_ref_R.begin(), pars_ref_R.nrow(), pars_ref_R.ncol(), false, true);
+      arma::vec loglik_rows(loglik_rows_R.begin(), loglik_rows_R.size(), false, true);
+
+      arma::mat pars(lna_parameters.begin(), lna_parameters.nrow(), lna_parameters.ncol(), false, true);
+      arma::mat census(censusmat.begin(), censusmat.nrow(), censusmat.ncol(), false, true);
+      arma::mat emit(emitmat.begin(), emitmat.nrow(), emitmat.ncol(), false, true);
+      arma::uvec census_inds = Rcpp::as<arma::uvec>(census_indices);
+
+      // the initial volumes are not changed by the update
+      arma::rowvec init_state(lna_initdist_inds.size());
+      for(int j = 0; j < lna_initdist_inds.size(); ++j) init_state[j] = pars(0, lna_initdist_inds[j]);
+
+      // the census and emission matrices may have been modified by other updates
+      bool cache_valid = false;
+
+      std::function<double(arma::mat&)> proposal_loglik = [&](arma::mat& pathmat) {
+
+            double loglik = R_NegInf;
+
+            try {
+                  map_draws_2_lna(pathmat, draws, lna_times, lna_parameters, lna_param_vec, lna_param_inds,
+                                  lna_tcovar_inds, lna_initdist_inds[0], param_update_inds, stoich_matrix,
+                                  forcing_inds, forcing_tcov_inds, forcings_out, forcing_transfers,
+                                  svd_d, svd_U, svd_V, step_size, lna_pointer, lna_set_pars_pointer);
+
+                  // find the census intervals affected by the proposal
+                  int census_start = find_dirty_range(path_ref, pathmat, pars_ref, pars, census_inds, !cache_valid);
+                  cache_valid = false;
+
+                  census_lna(pathmat, census, census_inds, lna_event_inds, flow_matrix, do_prevalence,
+                             init_state, pars, forcing_inds, forcing_tcov_inds, forcings_out,
+                             forcing_transfers, census_start);
+
+                  evaluate_d_measure_LNA(emitmat, data, censusmat, obs_layout, lna_parameters, lna_param_inds,
+                                         lna_const_inds, lna_tcovar_inds, param_update_inds, census_indices,
+                                         lna_param_vec, d_meas_pointer, census_start);
+
+                  loglik = update_data_log_lik(loglik_rows, emit, obs_layout, census_start);
+                  if(ISNAN(loglik)) loglik = R_NegInf;
+                  cache_valid = true;
+
+            } catch(std::exception&) {
+                  loglik = R_NegInf;
+            }
+
+            return loglik;
+      };
+
+      tparam_blocks blocks = get_tparam_blocks(tparam);
+      double_buffer path(lna_path, pathmat_prop);
+
+      tparam_ess(blocks, pars, path, data_log_lik, proposal_loglik, tparam_steps, tparam_angle,
+                 tparam_bracket_width, n_tparam_updates);
+}
+
+//' Update the time-varying parameters of an ODE model via elliptical slice
+//' sampling, natively.
+//'
+//' All time-varying parameters must have compiled structures, see
+//' \code{\link{tpar_structure}}. The draws, path, and likelihood terms are
+//' updated in place. Arguments are as in \code{\link{update_tparam_ode}}.
+//'
+//' @inheritParams update_tparam_ode
+//'
+//' @return update the time-varying parameters and the path in place
+//' @export
+// [[Rcpp::export]]
+void tparam_ess_update_ode(const Rcpp::List& tparam,
+                           const Rcpp::List& path_cur,
+                           const Rcpp::NumericMatrix& data,
+                           Rcpp::NumericMatrix& ode_parameters,
+                           Rcpp::NumericVector& ode_param_vec,
+                           Rcpp::NumericMatrix& pathmat_prop,
+                           Rcpp::NumericMatrix& censusmat,
+                           Rcpp::NumericMatrix& emitmat,
+                           const arma::mat& flow_matrix,
+                           const arma::mat& stoich_matrix,
+                           const arma::rowvec& ode_times,
+                           const Rcpp::LogicalVector& forcing_inds,
+                           const arma::uvec& forcing_tcov_inds,
+                           const arma::mat& forcings_out,
+                           const arma::cube& forcing_transfers,
+                           const Rcpp::IntegerVector& ode_param_inds,
+                           const Rcpp::IntegerVector& ode_const_inds,
+                           const Rcpp::IntegerVector& ode_tcovar_inds,
+                           const Rcpp::IntegerVector& ode_initdist_inds,
+                           const Rcpp::LogicalVector& param_update_inds,
+                           const Rcpp::IntegerVector& census_indices,
+                           const arma::uvec& ode_event_inds,
+                           const Rcpp::List& obs_layout,
+                           SEXP ode_pointer,
+                           SEXP ode_set_pars_pointer,
+                           SEXP d_meas_pointer,
+                           bool do_prevalence,
+                           double step_size,
+                           Rcpp::NumericVector& tparam_steps,
+                           Rcpp::NumericVector& tparam_angle,
+                           double tparam_bracket_width,
+                           int n_tparam_updates) {
+
+      // the current path and data log likelihood
+      Rcpp::NumericMatrix ode_path     = path_cur["ode_path"];
+      Rcpp::NumericVector data_log_lik = path_cur["data_log_lik"];
+
+      arma::mat pars(ode_parameters.begin(), ode_parameters.nrow(), ode_parameters.ncol(), false, true);
+      arma::mat census(censusmat.begin(), censusmat.nrow(), censusmat.ncol(), false, true);
+      arma::mat emit(emitmat.begin(), emitmat.nrow(), emitmat.ncol(), false, true);
+      arma::uvec census_inds = Rcpp::as<arma::uvec>(census_indices);
+
+      // the initial volumes are not changed by the update
+      arma::rowvec init_state(ode_initdist_inds.size());
+      for(int j = 0; j < ode_initdist_inds.size(); ++j) init_state[j] = pars(0, ode_initdist_inds[j]);
+
+      std::function<double(arma::mat&)> proposal_loglik = [&](arma::mat& pathmat) {
+
+            double loglik = R_NegInf;
+
+            try {
+                  map_pars_2_ode(pathmat, ode_times, ode_parameters, ode_param_inds, ode_tcovar_inds,
+                                 ode_initdist_inds[0], param_update_inds, stoich_matrix, forcing_inds,
+                                 forcing_tcov_inds, forcings_out, forcing_transfers, step_size,
+                                 ode_pointer, ode_set_pars_pointer);
+
+                  census_lna(pathmat, census, census_inds, ode_event_inds, flow_matrix, do_prevalence,
+                             init_state, pars, forcing_inds, forcing_tcov_inds, forcings_out,
+                             forcing_transfers, 0);
+
+                  evaluate_d_measure_LNA(emitmat, data, censusmat, obs_layout, ode_parameters, ode_param_inds,
+                                         ode_const_inds, ode_tcovar_inds, param_update_inds, census_indices,
+                                         ode_param_vec, d_meas_pointer, 0);
+
+                  loglik = compute_data_log_lik(emit, obs_layout);
+                  if(ISNAN(loglik)) loglik = R_NegInf;
+
+            } catch(std::exception&) {
+                  loglik = R_NegInf;
+            }
+
+            return loglik;
+      };
+
+      tparam_blocks blocks = get_tparam_blocks(tparam);
+      double_buffer path(ode_path, pathmat_prop);
+
+      tparam_ess(blocks, pars, path, data_log_lik, proposal_loglik, tparam_steps, tparam_angle,
+                 tparam_bracket_width, n_tparam_updates);
+}
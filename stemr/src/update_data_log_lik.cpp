@@ -0,0 +1,50 @@
+// [[Rcpp::depends(RcppArmadillo)]]
+#include <RcppArmadillo.h>
+
+using namespace Rcpp;
+using namespace arma;
+
+//' Update the data log-likelihood contributions at each observation time and
+//' return the data log-likelihood.
+//'
+//' The contributions are stored untempered, the returned log-likelihood is
+//' tempered as in \code{\link{compute_data_log_lik}}.
+//'
+//' @param loglik_rows vector with the log-likelihood contribution of each row
+//'   of the emission matrix
+//' @param emitmat matrix of emission probabilities
+//' @param obs_layout list with the compressed observation layout, see
+//'   \code{build_obs_layout}
+//' @param row_start C++ index of the first row whose contribution should be
+//'   recomputed, contributions of earlier rows are kept as is.
+//'
+//' @return data log-likelihood, contributions are updated in place
+//' @export
+// [[Rcpp::export]]
+double update_data_log_lik(arma::vec& loglik_rows,
+                           const arma::mat& emitmat,
+                           const Rcpp::List& obs_layout,
+                           int row_start = 0) {
+
+      // variables observed at each observation time, in compressed row format
+      Rcpp::IntegerVector row_ptr  = obs_layout["row_ptr"];
+      Rcpp::IntegerVector col_inds = obs_layout["col_inds"];
+      int n_obstimes = row_ptr.size() - 1;
+
+      // sum the emission probabilities for the measured variables
+      for(int j = row_start; j < n_obstimes; ++j) {
+
+            loglik_rows[j] = 0;
+
+            for(int k = row_ptr[j]; k < row_ptr[j+1]; ++k) {
+                  loglik_rows[j] += emitmat(j, col_inds[k] + 1);
+            }
+      }
+
+      // tempered chains in replica exchange MCMC
+      if(obs_layout.containsElementNamed("inv_temperature")) {
+            return Rcpp::as<double>(obs_layout["inv_temperature"]) * arma::accu(loglik_rows);
+      }
+
+      return arma::accu(loglik_rows);
+}